@@ -4,6 +4,8 @@
 #include "AILibrary.h"
 #include "CharacterLibrary.h"
 #include "EODCharacterBase.h"
+#include "CombatZoneModeBase.h"
+#include "CombatManager.h"
 
 #include "AIController.h"
 #include "BehaviorTree/BlackboardComponent.h"
@@ -94,17 +96,43 @@ void UBTService_CheckForEnemies::LookForAnotherEnemy(UBehaviorTreeComponent& Own
 	BlackboardComp->SetValueAsObject(UAILibrary::BBKey_TargetEnemy, nullptr);
 	float AggroActivationRadius = BlackboardComp->GetValueAsFloat(UAILibrary::BBKey_AggroActivationRadius);
 
+	FVector OwnerLocation = CharacterOwner->GetActorLocation();
+	FVector SpawnLocation = BlackboardComp->GetValueAsVector(UAILibrary::BBKey_SpawnLocation);
+	float AggroAreaRadius = BlackboardComp->GetValueAsFloat(UAILibrary::BBKey_AggroAreaRadius);
+
+	// Use the combat manager's spatial hash to find nearby enemies without any physics queries
+	ACombatZoneModeBase* CombatZoneGameMode = Cast<ACombatZoneModeBase>(World->GetAuthGameMode());
+	ACombatManager* CombatManager = CombatZoneGameMode ? CombatZoneGameMode->GetCombatManager() : nullptr;
+	if (CombatManager)
+	{
+		TArray<AEODCharacterBase*> Candidates;
+		const FCharacterSpatialHash& SpatialHash = CombatManager->GetCharacterSpatialHash();
+		SpatialHash.QuerySphere(OwnerLocation, AggroActivationRadius, FCharacterQueryFilter(CharacterOwner, CharacterOwner), Candidates);
+
+		for (AEODCharacterBase* Candidate : Candidates)
+		{
+			if (IsValid(Candidate) && (SpawnLocation - Candidate->GetActorLocation()).Size() < AggroAreaRadius)
+			{
+				BlackboardComp->SetValueAsObject(UAILibrary::BBKey_TargetEnemy, Candidate);
+				BlackboardComp->SetValueAsBool(UAILibrary::BBKey_bHasEnemyTarget, true);
+
+				// Put character in combat state
+				CharacterOwner->SetInCombat(true);
+				return;
+			}
+		}
+
+		CharacterOwner->SetInCombat(false);
+		return;
+	}
+
 	TArray<FHitResult> HitResults;
 	FCollisionShape CollisionShape = FCollisionShape::MakeSphere(AggroActivationRadius);
 	FCollisionQueryParams Params = UCombatLibrary::GenerateCombatCollisionQueryParams(CharacterOwner);
-	FVector OwnerLocation = CharacterOwner->GetActorLocation();
 
 	FVector TraceEnd = OwnerLocation + FVector(0.f, 0.f, 1.f);
 	bool bHit = World->SweepMultiByChannel(HitResults, OwnerLocation, TraceEnd, FQuat::Identity, COLLISION_COMBAT, CollisionShape, Params);
 
-	FVector SpawnLocation = BlackboardComp->GetValueAsVector(UAILibrary::BBKey_SpawnLocation);
-	float AggroAreaRadius = BlackboardComp->GetValueAsFloat(UAILibrary::BBKey_AggroAreaRadius);
-
 	for (FHitResult& HitResult : HitResults)
 	{
 		AEODCharacterBase* HitCharacter = Cast<AEODCharacterBase>(HitResult.GetActor());
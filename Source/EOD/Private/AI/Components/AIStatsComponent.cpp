@@ -59,6 +59,9 @@ void UAIStatsComponent::LoadAIStats()
 		AIChar->SetCharacterLevel(TableRow->Level);
 	}
 
+	// Broadcast every stat change once, after all stats have been loaded
+	FScopedStatTransaction StatTransaction(this);
+
 	Health.SetMaxValue(TableRow->Health);
 	Health.RefillCurrentValue();
 
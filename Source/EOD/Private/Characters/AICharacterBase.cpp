@@ -101,97 +101,88 @@ void AAICharacterBase::Destroyed()
 	Super::Destroyed();
 }
 
-bool AAICharacterBase::CCEFlinch(const float BCAngle)
+bool AAICharacterBase::ApplyFlinch(const float BCAngle)
 {
-	if (CanFlinch())
+	if (FlinchMontage)
 	{
-		if (FlinchMontage)
+		if (BCAngle <= 90)
 		{
-			if (BCAngle <= 90)
-			{
-				PlayAnimMontage(FlinchMontage, 1.f, UCharacterLibrary::SectionName_ForwardFlinch);
-			}
-			else
-			{
-				PlayAnimMontage(FlinchMontage, 1.f, UCharacterLibrary::SectionName_BackwardFlinch);
-			}
-			return true;
+			PlayAnimMontage(FlinchMontage, 1.f, UCharacterLibrary::SectionName_ForwardFlinch);
 		}
+		else
+		{
+			PlayAnimMontage(FlinchMontage, 1.f, UCharacterLibrary::SectionName_BackwardFlinch);
+		}
+		return true;
 	}
 	return false;
 }
 
-bool AAICharacterBase::CCEInterrupt(const float BCAngle)
+bool AAICharacterBase::ApplyInterrupt(const float BCAngle)
 {
-	if (CanInterrupt())
+	if (InterruptMontage)
 	{
-		if (InterruptMontage)
+		PreCCEStateEnter();
+
+		float InterruptDuration = 0.f;
+		int32 NumOfSections = 2; // Forward interrupt and backward interrupt
+		if (BCAngle <= 90)
+		{
+			InterruptDuration = (PlayAnimMontage(InterruptMontage, 1.f, UCharacterLibrary::SectionName_ForwardInterrupt)) / 2;
+		}
+		else
+		{
+			InterruptDuration = (PlayAnimMontage(InterruptMontage, 1.f, UCharacterLibrary::SectionName_BackwardInterrupt)) / 2;
+		}
+
+		CharacterStateInfo.CharacterState = ECharacterState::GotHit;
+		bCharacterStateAllowsMovement = false;
+		bCharacterStateAllowsRotation = false;
+		UEODCharacterMovementComponent* MoveComp = Cast<UEODCharacterMovementComponent>(GetCharacterMovement());
+		if (MoveComp)
+		{
+			MoveComp->bUseControllerDesiredRotation = false;
+		}
+
+		InterruptDuration = InterruptDuration - InterruptMontage->BlendOut.GetBlendTime();
+		if (InterruptDuration > 0.f)
+		{
+			UWorld* World = GetWorld();
+			check(World);
+			World->GetTimerManager().SetTimer(CrowdControlTimerHandle, this, &AAICharacterBase::ResetState, InterruptDuration);
+		}
+		else
 		{
-			PreCCEStateEnter();
-
-			float InterruptDuration = 0.f;
-			int32 NumOfSections = 2; // Forward interrupt and backward interrupt
-			if (BCAngle <= 90)
-			{
-				InterruptDuration = (PlayAnimMontage(InterruptMontage, 1.f, UCharacterLibrary::SectionName_ForwardInterrupt)) / 2;
-			}
-			else
-			{
-				InterruptDuration = (PlayAnimMontage(InterruptMontage, 1.f, UCharacterLibrary::SectionName_BackwardInterrupt)) / 2;
-			}
-
-			CharacterStateInfo.CharacterState = ECharacterState::GotHit;
-			bCharacterStateAllowsMovement = false;
-			bCharacterStateAllowsRotation = false;
-			UEODCharacterMovementComponent* MoveComp = Cast<UEODCharacterMovementComponent>(GetCharacterMovement());
-			if (MoveComp)
-			{
-				MoveComp->bUseControllerDesiredRotation = false;
-			}
-
-			InterruptDuration = InterruptDuration - InterruptMontage->BlendOut.GetBlendTime();
-			if (InterruptDuration > 0.f)
-			{
-				UWorld* World = GetWorld();
-				check(World);
-				World->GetTimerManager().SetTimer(CrowdControlTimerHandle, this, &AAICharacterBase::ResetState, InterruptDuration);
-			}
-			else
-			{
-				ResetState();
-			}
-
-			return true;
+			ResetState();
 		}
+
+		return true;
 	}
 	return false;
 }
 
-bool AAICharacterBase::CCEStun(const float Duration)
+bool AAICharacterBase::ApplyStun(const float Duration)
 {
-	if (CanStun())
+	if (StunMontage)
 	{
-		if (StunMontage)
-		{
-			PreCCEStateEnter();
+		PreCCEStateEnter();
 
-			PlayAnimMontage(StunMontage, 1.f);
+		PlayAnimMontage(StunMontage, 1.f);
 
-			UWorld* World = GetWorld();
-			check(World);
-			World->GetTimerManager().SetTimer(CrowdControlTimerHandle, this, &AAICharacterBase::CCERemoveStun, Duration, false);
-
-			CharacterStateInfo.CharacterState = ECharacterState::GotHit;
-			bCharacterStateAllowsMovement = false;
-			bCharacterStateAllowsRotation = false;
-			UEODCharacterMovementComponent* MoveComp = Cast<UEODCharacterMovementComponent>(GetCharacterMovement());
-			if (MoveComp)
-			{
-				MoveComp->bUseControllerDesiredRotation = false;
-			}
-
-			return true;
+		UWorld* World = GetWorld();
+		check(World);
+		World->GetTimerManager().SetTimer(CrowdControlTimerHandle, this, &AAICharacterBase::CCERemoveStun, Duration, false);
+
+		CharacterStateInfo.CharacterState = ECharacterState::GotHit;
+		bCharacterStateAllowsMovement = false;
+		bCharacterStateAllowsRotation = false;
+		UEODCharacterMovementComponent* MoveComp = Cast<UEODCharacterMovementComponent>(GetCharacterMovement());
+		if (MoveComp)
+		{
+			MoveComp->bUseControllerDesiredRotation = false;
 		}
+
+		return true;
 	}
 	return false;
 }
@@ -210,9 +201,9 @@ void AAICharacterBase::CCERemoveStun()
 	World->GetTimerManager().ClearTimer(CrowdControlTimerHandle);
 }
 
-bool AAICharacterBase::CCEFreeze(const float Duration)
+bool AAICharacterBase::ApplyFreeze(const float Duration)
 {
-	if (CanFreeze() && GetMesh())
+	if (GetMesh())
 	{
 		PreCCEStateEnter();
 
@@ -250,31 +241,28 @@ void AAICharacterBase::CCEUnfreeze()
 	World->GetTimerManager().ClearTimer(CrowdControlTimerHandle);
 }
 
-bool AAICharacterBase::CCEKnockdown(const float Duration)
+bool AAICharacterBase::ApplyKnockdown(const float Duration)
 {
-	if (CanKnockdown())
+	if (KnockdownMontage)
 	{
-		if (KnockdownMontage)
-		{
-			PreCCEStateEnter();
+		PreCCEStateEnter();
 
-			PlayAnimMontage(KnockdownMontage, 1.f, UCharacterLibrary::SectionName_KnockdownStart);
+		PlayAnimMontage(KnockdownMontage, 1.f, UCharacterLibrary::SectionName_KnockdownStart);
 
-			UWorld* World = GetWorld();
-			check(World);
-			World->GetTimerManager().SetTimer(CrowdControlTimerHandle, this, &AAICharacterBase::CCEEndKnockdown, Duration, false);
-
-			CharacterStateInfo.CharacterState = ECharacterState::GotHit;
-			bCharacterStateAllowsMovement = false;
-			bCharacterStateAllowsRotation = false;
-			UEODCharacterMovementComponent* MoveComp = Cast<UEODCharacterMovementComponent>(GetCharacterMovement());
-			if (MoveComp)
-			{
-				MoveComp->bUseControllerDesiredRotation = false;
-			}
-
-			return true;
+		UWorld* World = GetWorld();
+		check(World);
+		World->GetTimerManager().SetTimer(CrowdControlTimerHandle, this, &AAICharacterBase::CCEEndKnockdown, Duration, false);
+
+		CharacterStateInfo.CharacterState = ECharacterState::GotHit;
+		bCharacterStateAllowsMovement = false;
+		bCharacterStateAllowsRotation = false;
+		UEODCharacterMovementComponent* MoveComp = Cast<UEODCharacterMovementComponent>(GetCharacterMovement());
+		if (MoveComp)
+		{
+			MoveComp->bUseControllerDesiredRotation = false;
 		}
+
+		return true;
 	}
 	return false;
 }
@@ -293,9 +281,9 @@ void AAICharacterBase::CCEEndKnockdown()
 	World->GetTimerManager().ClearTimer(CrowdControlTimerHandle);
 }
 
-bool AAICharacterBase::CCEKnockback(const float Duration, const FVector& ImpulseDirection)
+bool AAICharacterBase::ApplyKnockback(const float Duration, const FVector& ImpulseDirection)
 {
-	bool bKnockdownInitiated = CCEKnockdown(Duration);
+	bool bKnockdownInitiated = ApplyKnockdown(Duration);
 	if (bKnockdownInitiated)
 	{
 		PushBack(ImpulseDirection);
@@ -306,12 +294,15 @@ bool AAICharacterBase::CCEKnockback(const float Duration, const FVector& Impulse
 
 bool AAICharacterBase::IsEnemyOf(ICombatInterface* TargetCI) const
 {
-	AActor* Target = TargetCI->GetInterfaceOwner();
-	if (Target->IsA(AAICharacterBase::StaticClass()))
-	{
-		return false;
-	}
-	return true;
+	// Same rule as UCharacterLibrary::AreEnemies, which AI characters use to pick their targets
+	const AEODCharacterBase* TargetCharacter = Cast<AEODCharacterBase>(TargetCI->GetInterfaceOwner());
+	return TargetCharacter ? TargetCharacter->GetFaction() != GetFaction() : true;
+}
+
+FMaskFilter AAICharacterBase::GetCombatIgnoreMask() const
+{
+	// AI characters never attack characters of their own faction (see IsEnemyOf), so skip own faction in combat queries.
+	return UCharacterLibrary::GetFactionMaskFilter(GetFaction());
 }
 
 USoundBase* AAICharacterBase::GetMeleeHitSound(const TEnumAsByte<EPhysicalSurface> HitSurface, const bool bCritHit) const
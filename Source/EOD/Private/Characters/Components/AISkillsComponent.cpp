@@ -5,11 +5,22 @@
 #include "AISkillBase.h"
 #include "AICharacterBase.h"
 #include "EODAIControllerBase.h"
+#include "CombatZoneModeBase.h"
+#include "CombatManager.h"
+#include "StatsComponentBase.h"
+#include "EODGameInstance.h"
+
+#include "Engine/World.h"
 
 UAISkillsComponent::UAISkillsComponent(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
 {
 	//~ @todo Find an appropriate value for maximum melee range
 	MaxMeleeRange = 50.f;
+	SkillUtilityDataTable = nullptr;
+	SkillUtilityRowName = NAME_None;
+
+	FMemory::Memzero(SkillBuckets);
+	AvailableSkillsMask = 0;
 }
 
 void UAISkillsComponent::BeginPlay()
@@ -27,7 +38,7 @@ void UAISkillsComponent::TickComponent(float DeltaTime, ELevelTick TickType, FAc
 void UAISkillsComponent::InitializeSkills(AEODCharacterBase* CompOwner)
 {
 	// If skills have already been initialized
-	if (SkillIndexToSkillMap.Num() > 0)
+	if (Skills.Num() > 0)
 	{
 		return;
 	}
@@ -39,48 +50,36 @@ void UAISkillsComponent::InitializeSkills(AEODCharacterBase* CompOwner)
 	}
 
 	check(CompOwner);
-	if (!SkillsDataTable)
+	UEODGameInstance* GI = Cast<UEODGameInstance>(CompOwner->GetGameInstance());
+	if (!SkillsDataTable || !GI)
 	{
 		return;
 	}
 
-	FString ContextString = FString("UAISkillsComponent::InitializeSkills()");
-	TArray<FName> Keys = SkillsDataTable->GetRowNames();
-	uint8 SkillIndex = 1;
-	for (FName Key : Keys)
+	// AI skills don't hold any per character state, so every AI character using the same data table shares the same skill objects
+	for (UGameplaySkillBase* Skill : GI->GetSharedSkills(SkillsDataTable))
 	{
-		FGameplaySkillTableRow* Row = SkillsDataTable->FindRow<FGameplaySkillTableRow>(Key, ContextString);
-		check(Row);
-		UGameplaySkillBase* GameplaySkill = NewObject<UGameplaySkillBase>(this, Row->SkillClass, Key, RF_Transient);
-		check(GameplaySkill);
-		GameplaySkill->InitSkill(CompOwner, CompOwner->Controller);
-		GameplaySkill->SetSkillIndex(SkillIndex);
-
-		if (GameplaySkill->GetSkillGroup() == NAME_None)
-		{
-			GameplaySkill->SetSkillGroup(Key);
-		}
-		else
+		if (Skill)
 		{
-			check(GameplaySkill->GetSkillGroup() == Key);
+			AddSkill(Skill);
 		}
-
-		SkillIndexToSkillMap.Add(GameplaySkill->GetSkillIndex(), GameplaySkill);
-		SkillGroupToSkillMap.Add(GameplaySkill->GetSkillGroup(), GameplaySkill);
-		SkillGroupToSkillIndexMap.Add(GameplaySkill->GetSkillGroup(), GameplaySkill->GetSkillIndex());
-
-		SkillIndex++;
 	}
 
 	GenerateSkillTypesList();
+
+	FString ContextString = FString("UAISkillsComponent::InitializeSkills()");
+	FAISkillUtilityTableRow* UtilityRow = SkillUtilityDataTable ? SkillUtilityDataTable->FindRow<FAISkillUtilityTableRow>(SkillUtilityRowName, ContextString) : nullptr;
+	if (UtilityRow)
+	{
+		SkillUtilityWeights = *UtilityRow;
+	}
 }
 
 void UAISkillsComponent::TriggerSkill(uint8 SkillIndex, UGameplaySkillBase* Skill)
 {
 	AEODCharacterBase* CharOwner = GetCharacterOwner();
 
-	check(SkillIndexToSkillMap.Contains(SkillIndex));
-	UAISkillBase* AISkill = Skill ? Cast<UAISkillBase>(Skill) : Cast<UAISkillBase>(SkillIndexToSkillMap[SkillIndex]);
+	UAISkillBase* AISkill = Cast<UAISkillBase>(Skill ? Skill : GetSkill(SkillIndex));
 
 	if (!AISkill|| !CharOwner)
 	{
@@ -90,11 +89,11 @@ void UAISkillsComponent::TriggerSkill(uint8 SkillIndex, UGameplaySkillBase* Skil
 	bool bIsLocalCharacter = CharOwner->Controller && CharOwner->Controller->IsLocalController();
 	if (bIsLocalCharacter)
 	{
-		if (AISkill->CanTriggerSkill())
+		if (AISkill->CanTriggerSkillFor(this))
 		{
 			// For AI characters, the controller only exists on server (i.e., where the characters are local)
 			// So, we don't really need to check for CharOwner's role and call server RPC to trigger skill
-			AISkill->TriggerSkill();
+			AISkill->TriggerSkillFor(this);
 
 			if (AISkill->bSkillCanBeCharged)
 			{
@@ -104,11 +103,17 @@ void UAISkillsComponent::TriggerSkill(uint8 SkillIndex, UGameplaySkillBase* Skil
 			LastUsedSkillGroup = AISkill->GetSkillGroup();
 			LastUsedSkillIndex = SkillIndex;
 			ActiveSkills.Add(AISkill);
+
+			if (AISkill->SkillInfo.Cooldown > 0.f)
+			{
+				AvailableSkillsMask &= ~GetSkillMask(SkillIndex);
+				StartSkillCooldown(SkillIndex, AISkill->SkillInfo.Cooldown);
+			}
 		}
 	}
 	else
 	{
-		AISkill->TriggerSkill();
+		AISkill->TriggerSkillFor(this);
 		ActiveSkills.Add(AISkill);
 		OnSkillTriggered(SkillIndex, AISkill->GetSkillGroup(), AISkill);
 	}
@@ -120,11 +125,42 @@ void UAISkillsComponent::ReleaseSkill(uint8 SkillIndex, UGameplaySkillBase* Skil
 
 void UAISkillsComponent::CancelSkill(uint8 SkillIndex, UGameplaySkillBase* Skill)
 {
+	if (Skill == nullptr)
+	{
+		Skill = GetSkill(SkillIndex);
+	}
+
+	UAISkillBase* AISkill = Cast<UAISkillBase>(Skill);
+	if (AISkill && ActiveSkills.Contains(AISkill))
+	{
+		AISkill->CancelSkillFor(this);
+	}
 }
 
 void UAISkillsComponent::CancelAllActiveSkills()
 {
-	Super::CancelAllActiveSkills();
+	// It's important to loop in reverse because CancelSkillFor() modifies the ActiveSkills array.
+	int32 SkillsNum = ActiveSkills.Num();
+	for (int i = SkillsNum - 1; i >= 0; i--)
+	{
+		UAISkillBase* AISkill = Cast<UAISkillBase>(ActiveSkills[i]);
+		check(AISkill);
+		AISkill->CancelSkillFor(this);
+	}
+}
+
+void UAISkillsComponent::CancelSkillsWithTag(FGameplayTag Tag)
+{
+	// It's important to loop in reverse because CancelSkillFor() modifies the ActiveSkills array.
+	int32 SkillsNum = ActiveSkills.Num();
+	for (int i = SkillsNum - 1; i >= 0; i--)
+	{
+		UAISkillBase* AISkill = Cast<UAISkillBase>(ActiveSkills[i]);
+		if (AISkill && AISkill->AbilityTags.HasTag(Tag))
+		{
+			AISkill->CancelSkillFor(this);
+		}
+	}
 }
 
 bool UAISkillsComponent::CanUseAnySkill() const
@@ -134,18 +170,13 @@ bool UAISkillsComponent::CanUseAnySkill() const
 
 bool UAISkillsComponent::CanUseSkill(uint8 SkillIndex, UGameplaySkillBase* Skill)
 {
-	if (!SkillIndexToSkillMap.Contains(SkillIndex))
-	{
-		return false;
-	}
-
-	UAISkillBase* AISkill = Skill ? Cast<UAISkillBase>(Skill) : Cast<UAISkillBase>(SkillIndexToSkillMap[SkillIndex]);
+	UAISkillBase* AISkill = Cast<UAISkillBase>(Skill ? Skill : GetSkill(SkillIndex));
 	if (!AISkill)
 	{
 		return false;
 	}
 
-	bool bCanTriggerSkill = AISkill->CanTriggerSkill();
+	bool bCanTriggerSkill = AISkill->CanTriggerSkillFor(this);
 	return bCanTriggerSkill;
 }
 
@@ -171,6 +202,28 @@ void UAISkillsComponent::OnSkillFinished(uint8 SkillIndex, FName SkillGroup, UGa
 	}
 }
 
+bool UAISkillsComponent::GetAttackInfo(FName SkillGroup, int32 CollisionIndex, FAttackInfo& OutAttackInfo)
+{
+	UAISkillBase* AISkill = Cast<UAISkillBase>(GetSkillForSkillGroup(SkillGroup));
+	return AISkill ? AISkill->GetAttackInfoFor(this, CollisionIndex, OutAttackInfo) : false;
+}
+
+void UAISkillsComponent::FinishActiveSkill(uint8 SkillIndex)
+{
+	UAISkillBase* AISkill = Cast<UAISkillBase>(GetSkill(SkillIndex));
+	if (AISkill && ActiveSkills.Contains(AISkill))
+	{
+		AISkill->FinishSkillFor(this);
+	}
+}
+
+void UAISkillsComponent::OnSkillCooldownFinished(uint8 SkillIndex)
+{
+	Super::OnSkillCooldownFinished(SkillIndex);
+
+	AvailableSkillsMask |= GetSkillMask(SkillIndex);
+}
+
 FName UAISkillsComponent::GetMostWeightedSkillID(const AEODCharacterBase* TargetCharacter) const
 {
 	if (!TargetCharacter)
@@ -178,134 +231,47 @@ FName UAISkillsComponent::GetMostWeightedSkillID(const AEODCharacterBase* Target
 		return NAME_None;
 	}
 
-	AAICharacterBase* AIChar = Cast<AAICharacterBase>(GetOwner());
-	const FVector& AILocation = AIChar->GetActorLocation();
-	const FVector& EnemyLocation = TargetCharacter->GetActorLocation();
-	float Distance = (EnemyLocation - AILocation).Size();
-
 	//~ @todo If the character needs healing, prioritize healing
 	//~ @todo If allies are nearby and need healing, prioritize healing them unless we're are under attack
 	//~ @todo If allies are nearby and fighting, buff them unless we're under attack
 	//~ @todo If low on health, run away and attempt to heal
 
-	FName WeightedSkillID;
-	if (Distance > MaxMeleeRange)
-	{
-		WeightedSkillID = GetMostWeightedRangedSkillID(TargetCharacter);
-		//~ @todo in case we don't find an appropriate ranged skill to attack with, we should reposition AI character
-	}
-	else
-	{
-		WeightedSkillID = GetMostWeightedMeleeSkillID(TargetCharacter);
-		//~ @todo	in case we don't find an appropriate melee skill to attack with
-		//			we should try and pick a ranged skill
-	}
-
-	//~ @todo FailSafe in-case character has only one skill
-
-	return WeightedSkillID;
+	// Melee and ranged skills are scored together, and the distance to the target is weighed in by the range penalty
+	const uint64 SkillMask = SkillBuckets[(int32)ESkillEffect::DamageMelee][(int32)EAISkillProperty::Any] | SkillBuckets[(int32)ESkillEffect::DamageRanged][(int32)EAISkillProperty::Any];
+	return GetHighestUtilitySkill(SkillMask, TargetCharacter);
 }
 
 FName UAISkillsComponent::GetMostWeightedMeleeSkillID(const AEODCharacterBase* TargetCharacter) const
 {
-	TArray<FName> SkillsToIgnore;
-	SkillsToIgnore.Add(LastUsedSkillGroup);
-
-	/**
-	 * Logic:
-	 *	If enemy is blocking, try and get an unblockable skill.
-	 *	If enemy is under CCE, then try and get a normal skill.
-	 *	If enemy is dodging, then try and get an undodgable skill.
-	 *	If enemy is using a skill, then try and get an interrupt skill.
-	 *	If enemy is doing nothing (Idle-Walk-Run), then try and get any CCE skill.
-	 */
-
-	FName WeightedSkillID = NAME_None;
-	if (TargetCharacter->IsBlocking())
-	{
-		WeightedSkillID = GetRandomUnblockableSkill(MeleeSkills, SkillsToIgnore);
-	}
-	else if (TargetCharacter->IsDodging())
-	{
-		WeightedSkillID = GetRandomUndodgableSkill(MeleeSkills, SkillsToIgnore);
-	}
-	else if (TargetCharacter->IsUsingAnySkill())
-	{
-		WeightedSkillID = GetRandomInterruptSkill(MeleeSkills, SkillsToIgnore);
-	}
-	else if (TargetCharacter->HasBeenHit())
-	{
-		WeightedSkillID = GetRandomNormalSkill(MeleeSkills, SkillsToIgnore);
-	}
-	else
-	{
-		WeightedSkillID = GetRandomCCESkill(MeleeSkills, SkillsToIgnore);
-	}
-
-	if (WeightedSkillID == NAME_None)
+	if (!TargetCharacter)
 	{
-		WeightedSkillID = GetAnyRandomSkill(MeleeSkills, TArray<FName>());
+		return NAME_None;
 	}
 
-	return WeightedSkillID;
+	return GetHighestUtilitySkill(SkillBuckets[(int32)ESkillEffect::DamageMelee][(int32)EAISkillProperty::Any], TargetCharacter);
 }
 
 FName UAISkillsComponent::GetMostWeightedRangedSkillID(const AEODCharacterBase* TargetCharacter) const
 {
-	TArray<FName> SkillsToIgnore;
-	SkillsToIgnore.Add(LastUsedSkillGroup);
-
-	/**
-	 * Logic:
-	 *	If enemy is blocking, try and get an unblockable skill.
-	 *	If enemy is under CCE, then try and get a normal skill.
-	 *	If enemy is dodging, then try and get an undodgable skill.
-	 *	If enemy is using a skill, then try and get an interrupt skill.
-	 *	If enemy is doing nothing (Idle-Walk-Run), then try and get any CCE skill.
-	 */
-
-	FName WeightedSkillID = NAME_None;
-	if (TargetCharacter->IsBlocking())
-	{
-		WeightedSkillID = GetRandomUnblockableSkill(RangedSkills, SkillsToIgnore);
-	}
-	else if (TargetCharacter->IsDodging())
-	{
-		WeightedSkillID = GetRandomUndodgableSkill(RangedSkills, SkillsToIgnore);
-	}
-	else if (TargetCharacter->IsUsingAnySkill())
-	{
-		WeightedSkillID = GetRandomInterruptSkill(RangedSkills, SkillsToIgnore);
-	}
-	else if (TargetCharacter->HasBeenHit())
-	{
-		WeightedSkillID = GetRandomNormalSkill(RangedSkills, SkillsToIgnore);
-	}
-	else
-	{
-		WeightedSkillID = GetRandomCCESkill(RangedSkills, SkillsToIgnore);
-	}
-
-	if (WeightedSkillID == NAME_None)
+	if (!TargetCharacter)
 	{
-		WeightedSkillID = GetAnyRandomSkill(RangedSkills, TArray<FName>());
+		return NAME_None;
 	}
 
-	return WeightedSkillID;
+	return GetHighestUtilitySkill(SkillBuckets[(int32)ESkillEffect::DamageRanged][(int32)EAISkillProperty::Any], TargetCharacter);
 }
 
 FName UAISkillsComponent::GetHealingSkillID(bool bPartyHeal) const
 {
 	//~ Prioritize party healing over solo healing.
 
-	TArray<FName> SkillsToIgnore;
-	SkillsToIgnore.Add(LastUsedSkillGroup);
+	const uint64 SkillsToIgnoreMask = GetSkillMask(LastUsedSkillIndex);
 
 	//~ @todo check if there's even a party before retreiving party healing skills
-	FName WeightedSkillID = GetAnyRandomSkill(PartyHealingSkills, SkillsToIgnore);
+	FName WeightedSkillID = GetRandomSkill(ESkillEffect::HealParty, EAISkillProperty::Any, SkillsToIgnoreMask);
 	if (WeightedSkillID == NAME_None)
 	{
-		WeightedSkillID = GetAnyRandomSkill(SelfHealingSkills, SkillsToIgnore);
+		WeightedSkillID = GetRandomSkill(ESkillEffect::HealSelf, EAISkillProperty::Any, SkillsToIgnoreMask);
 	}
 
 	return WeightedSkillID;
@@ -315,14 +281,13 @@ FName UAISkillsComponent::GetWeightedBuffSkillID(bool bPartyBuff) const
 {
 	//~ Prioritize party buffs over solo buffs.
 
-	TArray<FName> SkillsToIgnore;
-	SkillsToIgnore.Add(LastUsedSkillGroup);
+	const uint64 SkillsToIgnoreMask = GetSkillMask(LastUsedSkillIndex);
 
 	//~ @todo check if there's even a party before retreiving party buff skills
-	FName WeightedSkillID = GetAnyRandomSkill(PartyBuffSkills, SkillsToIgnore);
+	FName WeightedSkillID = GetRandomSkill(ESkillEffect::BuffParty, EAISkillProperty::Any, SkillsToIgnoreMask);
 	if (WeightedSkillID == NAME_None)
 	{
-		WeightedSkillID = GetAnyRandomSkill(SelfBuffSkills, SkillsToIgnore);
+		WeightedSkillID = GetRandomSkill(ESkillEffect::BuffSelf, EAISkillProperty::Any, SkillsToIgnoreMask);
 	}
 
 	return WeightedSkillID;
@@ -330,22 +295,30 @@ FName UAISkillsComponent::GetWeightedBuffSkillID(bool bPartyBuff) const
 
 FName UAISkillsComponent::GetWeightedDebuffSkillID() const
 {
-	TArray<FName> SkillsToIgnore;
-	SkillsToIgnore.Add(LastUsedSkillGroup);
-	FName WeightedSkillID = GetAnyRandomSkill(DebuffSkills, SkillsToIgnore);
+	const uint64 SkillsToIgnoreMask = GetSkillMask(LastUsedSkillIndex);
+	FName WeightedSkillID = GetRandomSkill(ESkillEffect::DebuffEnemy, EAISkillProperty::Any, SkillsToIgnoreMask);
 	return WeightedSkillID;
 }
 
 void UAISkillsComponent::GenerateSkillTypesList()
 {
-	TArray<FName> Keys;
-	SkillGroupToSkillMap.GetKeys(Keys);
+	FMemory::Memzero(SkillBuckets);
+	SkillSlots.Reset();
+	SkillSlots.SetNum(MaxSkills);
+	AvailableSkillsMask = 0;
 
-	for (FName Key : Keys)
+	for (UGameplaySkillBase* Skill : Skills)
 	{
-		UAISkillBase* AISkill = Cast<UAISkillBase>(SkillGroupToSkillMap[Key]);
+		// Index 0 is not a valid skill index
+		if (!Skill)
+		{
+			continue;
+		}
+
+		UAISkillBase* AISkill = Cast<UAISkillBase>(Skill);
 		check(AISkill);
 
+		const FName Key = AISkill->GetSkillGroup();
 		ESkillEffect SkillEffect = AISkill->GetSkillEffect();
 		switch (SkillEffect)
 		{
@@ -373,101 +346,151 @@ void UAISkillsComponent::GenerateSkillTypesList()
 		default:
 			break;
 		}
-	}
-}
 
-FName UAISkillsComponent::GetRandomUnblockableSkill(const TArray<FName>& SkillSource, const TArray<FName>& SkillsToIgnore) const
-{
-	TArray<FName> AvailableSkills = GetAvailableSkills(SkillSource, SkillsToIgnore);
-	TArray<FName> NormalAttackSkills;
-	for (const FName& Key : AvailableSkills)
-	{
-		UAISkillBase* AISkill = SkillGroupToSkillMap.Contains(Key) ? Cast<UAISkillBase>(SkillGroupToSkillMap[Key]) : nullptr;
-		if (AISkill)
+		const uint64 SkillMask = GetSkillMask(AISkill->GetSkillIndex());
+		if (!ensureMsgf(SkillMask != 0, TEXT("Skill %s can't be selected by AI since AI characters can have at most %d skills"), *Key.ToString(), MaxSkills))
 		{
-			if (AISkill->SkillInfo.bUnblockable)
-			{
-				NormalAttackSkills.Add(Key);
-			}
+			continue;
 		}
+
+		const FAISkillInfo& SkillInfo = AISkill->SkillInfo;
+		const ECrowdControlEffect CCEffect = SkillInfo.CCEffectInfo.CCEffect;
+
+		FAISkillSlot& SkillSlot = SkillSlots[AISkill->GetSkillIndex() - 1];
+		SkillSlot.SkillGroup = Key;
+		SkillSlot.DamageFactor = SkillInfo.DamagePercent / 100.f;
+		SkillSlot.CCEffect = CCEffect;
+		uint64* EffectBuckets = SkillBuckets[(int32)SkillEffect];
+		EffectBuckets[(int32)EAISkillProperty::Any] |= SkillMask;
+		EffectBuckets[(int32)EAISkillProperty::Unblockable] |= SkillInfo.bUnblockable ? SkillMask : 0;
+		EffectBuckets[(int32)EAISkillProperty::Undodgable] |= SkillInfo.bUndodgable ? SkillMask : 0;
+		EffectBuckets[(int32)EAISkillProperty::Interrupt] |= CCEffect == ECrowdControlEffect::Interrupt ? SkillMask : 0;
+		EffectBuckets[(int32)EAISkillProperty::CCE] |= CCEffect != ECrowdControlEffect::Flinch ? SkillMask : 0;
+		EffectBuckets[(int32)EAISkillProperty::Normal] |= CCEffect == ECrowdControlEffect::Flinch ? SkillMask : 0;
+
+		// Skills still in cooldown become available again once their cooldown ends
+		AvailableSkillsMask |= IsSkillInCooldown(AISkill->GetSkillIndex()) ? 0 : SkillMask;
 	}
-	return GetRandomName(NormalAttackSkills);
 }
 
-FName UAISkillsComponent::GetRandomUndodgableSkill(const TArray<FName>& SkillSource, const TArray<FName>& SkillsToIgnore) const
+FName UAISkillsComponent::GetRandomSkill(ESkillEffect SkillEffect, EAISkillProperty SkillProperty, uint64 SkillsToIgnoreMask) const
 {
-	TArray<FName> AvailableSkills = GetAvailableSkills(SkillSource, SkillsToIgnore);
-	TArray<FName> NormalAttackSkills;
-	for (const FName& Key : AvailableSkills)
-	{
-		UAISkillBase* AISkill = SkillGroupToSkillMap.Contains(Key) ? Cast<UAISkillBase>(SkillGroupToSkillMap[Key]) : nullptr;
-		if (AISkill)
-		{
-			if (AISkill->SkillInfo.bUndodgable)
-			{
-				NormalAttackSkills.Add(Key);
-			}
-		}
-	}
-	return GetRandomName(NormalAttackSkills);
+	const uint64 SkillMask = SkillBuckets[(int32)SkillEffect][(int32)SkillProperty] & AvailableSkillsMask & ~SkillsToIgnoreMask;
+	return GetRandomSkillFromMask(SkillMask);
 }
 
-FName UAISkillsComponent::GetRandomInterruptSkill(const TArray<FName>& SkillSource, const TArray<FName>& SkillsToIgnore) const
+FName UAISkillsComponent::GetRandomSkillFromMask(uint64 SkillMask) const
 {
-	TArray<FName> AvailableSkills = GetAvailableSkills(SkillSource, SkillsToIgnore);
-	TArray<FName> NormalAttackSkills;
-	for (const FName& Key : AvailableSkills)
+	const int32 NumSkills = (int32)FPlatformMath::CountBits(SkillMask);
+	if (NumSkills == 0)
 	{
-		UAISkillBase* AISkill = SkillGroupToSkillMap.Contains(Key) ? Cast<UAISkillBase>(SkillGroupToSkillMap[Key]) : nullptr;
-		if (AISkill)
-		{
-			if (AISkill->SkillInfo.CCEffectInfo.CCEffect != ECrowdControlEffect::Interrupt)
-			{
-				NormalAttackSkills.Add(Key);
-			}
-		}
+		return NAME_None;
 	}
-	return GetRandomName(NormalAttackSkills);
-}
 
-FName UAISkillsComponent::GetRandomCCESkill(const TArray<FName>& SkillSource, const TArray<FName>& SkillsToIgnore) const
-{
-	TArray<FName> AvailableSkills = GetAvailableSkills(SkillSource, SkillsToIgnore);
-	TArray<FName> NormalAttackSkills;
-	for (const FName& Key : AvailableSkills)
+	ACombatManager* CombatManager = GetCombatManager();
+	int32 RandomIndex = CombatManager ? CombatManager->GetCombatRandom().GetDecisionStream().RandRange(0, NumSkills - 1) : FMath::RandRange(0, NumSkills - 1);
+
+	// Clear the lowest set bits until the randomly picked skill is the lowest one
+	for (; RandomIndex > 0; RandomIndex--)
 	{
-		UAISkillBase* AISkill = SkillGroupToSkillMap.Contains(Key) ? Cast<UAISkillBase>(SkillGroupToSkillMap[Key]) : nullptr;
-		if (AISkill)
-		{
-			if (AISkill->SkillInfo.CCEffectInfo.CCEffect != ECrowdControlEffect::Flinch)
-			{
-				NormalAttackSkills.Add(Key);
-			}
-		}
+		SkillMask &= SkillMask - 1;
 	}
-	return GetRandomName(NormalAttackSkills);
+
+	const uint64 LowestSkillMask = SkillMask & (~SkillMask + 1);
+	const int32 SkillBit = (int32)FPlatformMath::FloorLog2_64(LowestSkillMask);
+	return SkillSlots[SkillBit].SkillGroup;
 }
 
-FName UAISkillsComponent::GetRandomNormalSkill(const TArray<FName>& SkillSource, const TArray<FName>& SkillsToIgnore) const
+FName UAISkillsComponent::GetHighestUtilitySkill(uint64 SkillMask, const AEODCharacterBase* TargetCharacter) const
 {
-	TArray<FName> AvailableSkills = GetAvailableSkills(SkillSource, SkillsToIgnore);
-	TArray<FName> NormalAttackSkills;
-	for (const FName& Key : AvailableSkills)
+	SkillMask &= AvailableSkillsMask;
+	const AActor* CompOwner = GetOwner();
+	if (SkillMask == 0 || !CompOwner)
 	{
-		UAISkillBase* AISkill = SkillGroupToSkillMap.Contains(Key) ? Cast<UAISkillBase>(SkillGroupToSkillMap[Key]) : nullptr;
-		if (AISkill)
+		return NAME_None;
+	}
+
+	// The snapshot is shared with every other AI character targeting the same character this frame
+	ACombatManager* CombatManager = GetCombatManager();
+	FAITargetSnapshot LocalSnapshot;
+	if (!CombatManager)
+	{
+		LocalSnapshot.Capture(TargetCharacter);
+	}
+	const FAITargetSnapshot& Target = CombatManager ? CombatManager->GetTargetSnapshot(TargetCharacter) : LocalSnapshot;
+
+	FRandomStream LocalStream;
+	if (!CombatManager)
+	{
+		LocalStream.Initialize(FMath::Rand());
+	}
+	const FRandomStream& DecisionStream = CombatManager ? CombatManager->GetCombatRandom().GetDecisionStream() : LocalStream;
+
+	const FAISkillUtilityTableRow& Weights = SkillUtilityWeights;
+	const FVector ToOwner = CompOwner->GetActorLocation() - Target.Location;
+	const bool bInMeleeRange = ToOwner.SizeSquared() <= FMath::Square(MaxMeleeRange);
+	const bool bBlockedByTarget = Target.bBlocking && FVector::DotProduct(Target.ForwardVector, ToOwner) > 0.f;
+	const bool bTargetIdle = !Target.bBlocking && !Target.bDodging && !Target.bUsingSkill && !Target.bHasBeenHit;
+	const float MissingHealthRatio = 1.f - Target.HealthRatio;
+
+	const uint64* MeleeBuckets = SkillBuckets[(int32)ESkillEffect::DamageMelee];
+	const uint64 LastUsedSkillMask = GetSkillMask(LastUsedSkillIndex);
+
+	FName BestSkillGroup = NAME_None;
+	float BestUtility = -MAX_flt;
+	while (SkillMask != 0)
+	{
+		const uint64 CurrentSkillMask = SkillMask & (~SkillMask + 1);
+		SkillMask &= SkillMask - 1;
+
+		const FAISkillSlot& SkillSlot = SkillSlots[(int32)FPlatformMath::FloorLog2_64(CurrentSkillMask)];
+		const bool bMelee = (MeleeBuckets[(int32)EAISkillProperty::Any] & CurrentSkillMask) != 0;
+		const uint64* Buckets = bMelee ? MeleeBuckets : SkillBuckets[(int32)ESkillEffect::DamageRanged];
+
+		float Utility = Weights.DamageVsLowHealth * SkillSlot.DamageFactor * MissingHealthRatio;
+		if (bBlockedByTarget)
 		{
-			if (AISkill->SkillInfo.CCEffectInfo.CCEffect == ECrowdControlEffect::Flinch)
-			{
-				NormalAttackSkills.Add(Key);
-			}
+			Utility += (Buckets[(int32)EAISkillProperty::Unblockable] & CurrentSkillMask) ? Weights.UnblockableVsBlocking : -Weights.BlockablePenalty;
+		}
+		if (Target.bDodging && (Buckets[(int32)EAISkillProperty::Undodgable] & CurrentSkillMask))
+		{
+			Utility += Weights.UndodgableVsDodging;
+		}
+		if (Target.bUsingSkill && (Buckets[(int32)EAISkillProperty::Interrupt] & CurrentSkillMask))
+		{
+			Utility += Weights.InterruptVsUsingSkill;
+		}
+		if (Target.bHasBeenHit && (Buckets[(int32)EAISkillProperty::Normal] & CurrentSkillMask))
+		{
+			Utility += Weights.NormalVsHit;
+		}
+		if (Buckets[(int32)EAISkillProperty::CCE] & CurrentSkillMask)
+		{
+			Utility += FCCImmunities::IsImmune(Target.CCImmunities, SkillSlot.CCEffect) ? -Weights.CCEImmunePenalty : (bTargetIdle ? Weights.CCEVsIdle : 0.f);
+		}
+		if (bMelee != bInMeleeRange)
+		{
+			Utility -= Weights.OutOfRangePenalty;
+		}
+		if (CurrentSkillMask == LastUsedSkillMask)
+		{
+			Utility -= Weights.LastUsedPenalty;
+		}
+		Utility += Weights.Randomness * DecisionStream.FRand();
+
+		if (Utility > BestUtility)
+		{
+			BestUtility = Utility;
+			BestSkillGroup = SkillSlot.SkillGroup;
 		}
 	}
-	return GetRandomName(NormalAttackSkills);
+
+	return BestSkillGroup;
 }
 
-FName UAISkillsComponent::GetAnyRandomSkill(const TArray<FName>& SkillSource, const TArray<FName>& SkillsToIgnore) const
+ACombatManager* UAISkillsComponent::GetCombatManager() const
 {
-	TArray<FName> AvailableSkills = GetAvailableSkills(SkillSource, SkillsToIgnore);
-	return GetRandomName(AvailableSkills);
+	UWorld* World = GetWorld();
+	ACombatZoneModeBase* CombatZoneGameMode = World ? Cast<ACombatZoneModeBase>(World->GetAuthGameMode()) : nullptr;
+	return CombatZoneGameMode ? CombatZoneGameMode->GetCombatManager() : nullptr;
 }
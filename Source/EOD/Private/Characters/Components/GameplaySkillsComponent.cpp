@@ -81,10 +81,10 @@ void UGameplaySkillsComponent::ReleaseSkill(uint8 SkillIndex, UGameplaySkillBase
 
 void UGameplaySkillsComponent::CancelSkill(uint8 SkillIndex, UGameplaySkillBase* Skill)
 {
-	check(SkillIndexToSkillMap.Contains(SkillIndex));
 	if (Skill == nullptr)
 	{
-		Skill = SkillIndexToSkillMap[SkillIndex];
+		Skill = GetSkill(SkillIndex);
+		check(Skill);
 	}
 
 	if (ActiveSkills.Contains(Skill))
@@ -126,10 +126,10 @@ bool UGameplaySkillsComponent::CanUseAnySkill() const
 
 bool UGameplaySkillsComponent::CanUseSkill(uint8 SkillIndex, UGameplaySkillBase* Skill)
 {
-	check(SkillIndexToSkillMap.Contains(SkillIndex));
 	if (Skill == nullptr)
 	{
-		Skill = SkillIndexToSkillMap[SkillIndex];
+		Skill = GetSkill(SkillIndex);
+		check(Skill);
 	}
 
 	return Skill ? Skill->CanTriggerSkill() : false;
@@ -141,12 +141,19 @@ void UGameplaySkillsComponent::ActivateChainSkill(UGameplaySkillBase* CurrentSki
 
 uint8 UGameplaySkillsComponent::GetSkillIndexForSkillGroup(FName SkillGroup) const
 {
-	return SkillGroupToSkillIndexMap.Contains(SkillGroup) ? SkillGroupToSkillIndexMap[SkillGroup] : 0;
+	return SkillGroupToSkillIndexMap.FindRef(SkillGroup);
 }
 
 UGameplaySkillBase* UGameplaySkillsComponent::GetSkillForSkillGroup(FName SkillGroup) const
 {
-	return SkillGroupToSkillMap.Contains(SkillGroup) ? SkillGroupToSkillMap[SkillGroup] : nullptr;
+	const uint8* SkillIndex = SkillGroupToSkillIndexMap.Find(SkillGroup);
+	return SkillIndex ? GetSkill(*SkillIndex) : nullptr;
+}
+
+bool UGameplaySkillsComponent::GetAttackInfo(FName SkillGroup, int32 CollisionIndex, FAttackInfo& OutAttackInfo)
+{
+	UGameplaySkillBase* Skill = GetSkillForSkillGroup(SkillGroup);
+	return Skill ? Skill->GetAttackInfo(CollisionIndex, OutAttackInfo) : false;
 }
 
 void UGameplaySkillsComponent::OnSkillCancelled(uint8 SkillIndex, FName SkillGroup, UGameplaySkillBase* Skill)
@@ -226,6 +233,21 @@ void UGameplaySkillsComponent::InitializeSkills(AEODCharacterBase* CompOwner)
 {
 }
 
+void UGameplaySkillsComponent::AddSkill(UGameplaySkillBase* Skill)
+{
+	check(Skill && Skill->IsValid());
+
+	const uint8 SkillIndex = Skill->GetSkillIndex();
+	if (!Skills.IsValidIndex(SkillIndex))
+	{
+		Skills.SetNumZeroed(SkillIndex + 1);
+	}
+
+	check(Skills[SkillIndex] == nullptr);
+	Skills[SkillIndex] = Skill;
+	SkillGroupToSkillIndexMap.Add(Skill->GetSkillGroup(), SkillIndex);
+}
+
 void UGameplaySkillsComponent::UpdateSkillCooldown(FName SkillGroup, float RemainingCooldown)
 {
 }
@@ -234,6 +256,90 @@ void UGameplaySkillsComponent::UpdateSkillCooldown(uint8 SkillIndex, float Remai
 {
 }
 
+void UGameplaySkillsComponent::StartSkillCooldown(uint8 SkillIndex, float Duration)
+{
+	UWorld* World = GetWorld();
+	if (!World || Duration <= 0.f)
+	{
+		return;
+	}
+
+	SkillCooldowns.StartCooldown(SkillIndex, World->GetTimeSeconds() + Duration);
+	ScheduleNextCooldownExpiry();
+
+	// UI reads the remaining cooldown on demand, so it only needs to be told when a cooldown starts and finishes
+	UGameplaySkillBase* Skill = GetSkill(SkillIndex);
+	if (Skill)
+	{
+		UpdateSkillCooldown(Skill->GetSkillGroup(), Duration);
+	}
+}
+
+void UGameplaySkillsComponent::CancelSkillCooldown(uint8 SkillIndex)
+{
+	if (SkillCooldowns.CancelCooldown(SkillIndex))
+	{
+		ScheduleNextCooldownExpiry();
+		OnSkillCooldownFinished(SkillIndex);
+	}
+}
+
+bool UGameplaySkillsComponent::IsSkillInCooldown(uint8 SkillIndex) const
+{
+	UWorld* World = GetWorld();
+	return World ? SkillCooldowns.IsInCooldown(SkillIndex, World->GetTimeSeconds()) : false;
+}
+
+float UGameplaySkillsComponent::GetRemainingCooldown(uint8 SkillIndex) const
+{
+	UWorld* World = GetWorld();
+	return World ? SkillCooldowns.GetRemainingTime(SkillIndex, World->GetTimeSeconds()) : 0.f;
+}
+
+void UGameplaySkillsComponent::OnSkillCooldownFinished(uint8 SkillIndex)
+{
+	UGameplaySkillBase* Skill = GetSkill(SkillIndex);
+	if (Skill)
+	{
+		UpdateSkillCooldown(Skill->GetSkillGroup(), 0.f);
+	}
+}
+
+void UGameplaySkillsComponent::ScheduleNextCooldownExpiry()
+{
+	UWorld* World = GetWorld();
+	if (!World)
+	{
+		return;
+	}
+
+	float NextEndTime;
+	if (SkillCooldowns.GetNextEndTime(NextEndTime))
+	{
+		const float Delay = FMath::Max(NextEndTime - World->GetTimeSeconds(), KINDA_SMALL_NUMBER);
+		World->GetTimerManager().SetTimer(CooldownTimerHandle, this, &UGameplaySkillsComponent::OnCooldownTimerExpired, Delay, false);
+	}
+	else
+	{
+		World->GetTimerManager().ClearTimer(CooldownTimerHandle);
+	}
+}
+
+void UGameplaySkillsComponent::OnCooldownTimerExpired()
+{
+	UWorld* World = GetWorld();
+	check(World);
+
+	const float CurrentTime = World->GetTimeSeconds();
+	uint8 SkillIndex;
+	while (SkillCooldowns.PopExpiredCooldown(CurrentTime, SkillIndex))
+	{
+		OnSkillCooldownFinished(SkillIndex);
+	}
+
+	ScheduleNextCooldownExpiry();
+}
+
 void UGameplaySkillsComponent::AddGameplayEffect(UGameplayEffectBase* GameplayEffect)
 {
 	if (GameplayEffect)
@@ -48,15 +48,12 @@ void UPlayerSkillsComponent::OnPressingSkillKey(const int32 SkillKeyIndex)
 	{
 		SkillIndex = SupersedingChainSkillGroup.Value;
 	}
-	else if (SkillBarMap.Contains(SkillKeyIndex))
+	else
 	{
-		SkillIndex = SkillBarMap[SkillKeyIndex];
+		SkillIndex = SkillBarMap.FindRef(SkillKeyIndex);
 	}
 
-	if (SkillIndexToSkillMap.Contains(SkillIndex))
-	{
-		Skill = SkillIndexToSkillMap[SkillIndex];
-	}
+	Skill = GetSkill(SkillIndex);
 
 	// Do not call TriggerSkill if Skill is nullptr
 	if (Skill)
@@ -70,15 +67,8 @@ void UPlayerSkillsComponent::OnReleasingSkillKey(const int32 SkillKeyIndex)
 	uint8 SkillIndex = 0;
 	UGameplaySkillBase* Skill = nullptr;
 
-	if (SkillBarMap.Contains(SkillKeyIndex))
-	{
-		SkillIndex = SkillBarMap[SkillKeyIndex];
-	}
-
-	if (SkillIndexToSkillMap.Contains(SkillIndex))
-	{
-		Skill = SkillIndexToSkillMap[SkillIndex];
-	}
+	SkillIndex = SkillBarMap.FindRef(SkillKeyIndex);
+	Skill = GetSkill(SkillIndex);
 
 	if (Skill)
 	{
@@ -92,7 +82,7 @@ void UPlayerSkillsComponent::OnReleasingSkillKey(const int32 SkillKeyIndex)
 void UPlayerSkillsComponent::InitializeSkills(AEODCharacterBase* CompOwner)
 {
 	// If skills have already been initialized
-	if (SkillIndexToSkillMap.Num() > 0)
+	if (Skills.Num() > 0)
 	{
 		return;
 	}
@@ -132,9 +122,7 @@ void UPlayerSkillsComponent::InitializeSkills(AEODCharacterBase* CompOwner)
 			check(GameplaySkill->GetSkillGroup() == Key);
 		}
 
-		SkillIndexToSkillMap.Add(GameplaySkill->GetSkillIndex(), GameplaySkill);
-		SkillGroupToSkillMap.Add(GameplaySkill->GetSkillGroup(), GameplaySkill);
-		SkillGroupToSkillIndexMap.Add(GameplaySkill->GetSkillGroup(), GameplaySkill->GetSkillIndex());
+		AddSkill(GameplaySkill);
 
 		SkillIndex++;
 	}
@@ -162,8 +150,8 @@ void UPlayerSkillsComponent::InitializeSkills(AEODCharacterBase* CompOwner)
 
 bool UPlayerSkillsComponent::AddSkillToSkillBar(uint8 SkillBarIndex, FName SkillGroup)
 {
-	uint8 SkillIndex = SkillGroupToSkillIndexMap.Contains(SkillGroup) ? SkillGroupToSkillIndexMap[SkillGroup] : 0;
-	if (SkillIndex == 0 || !SkillIndexToSkillMap.Contains(SkillIndex))
+	uint8 SkillIndex = GetSkillIndexForSkillGroup(SkillGroup);
+	if (!GetSkill(SkillIndex))
 	{
 		return false;
 	}
@@ -182,9 +170,9 @@ bool UPlayerSkillsComponent::SwapSkillsOnSkillBar(uint8 SBI1, FName SG1, uint8 S
 {
 	check(SBI1 != SBI2);
 
-	uint8 SI1 = SkillGroupToSkillIndexMap.Contains(SG1) ? SkillGroupToSkillIndexMap[SG1] : 0;
-	uint8 SI2 = SkillGroupToSkillIndexMap.Contains(SG2) ? SkillGroupToSkillIndexMap[SG2] : 0;
-	if (SI1 == 0 || SI2 == 0 || !SkillIndexToSkillMap.Contains(SI1) || !SkillIndexToSkillMap.Contains(SI2))
+	uint8 SI1 = GetSkillIndexForSkillGroup(SG1);
+	uint8 SI2 = GetSkillIndexForSkillGroup(SG2);
+	if (!GetSkill(SI1) || !GetSkill(SI2))
 	{
 		return false;
 	}
@@ -197,13 +185,7 @@ bool UPlayerSkillsComponent::SwapSkillsOnSkillBar(uint8 SBI1, FName SG1, uint8 S
 
 UPlayerSkillBase const* const UPlayerSkillsComponent::GetSkillAtSkillBarIndex(uint8 SkillBarIndex) const
 {
-	uint8 SkillIndex = SkillBarMap.Contains(SkillBarIndex) ? SkillBarMap[SkillBarIndex] : 0;
-	if (SkillIndex == 0 || !SkillIndexToSkillMap.Contains(SkillIndex))
-	{
-		return nullptr;
-	}
-
-	return Cast<UPlayerSkillBase>(SkillIndexToSkillMap[SkillIndex]);
+	return Cast<UPlayerSkillBase>(GetSkill(SkillBarMap.FindRef(SkillBarIndex)));
 }
 
 bool UPlayerSkillsComponent::SaveSkillBarMap()
@@ -225,8 +207,7 @@ void UPlayerSkillsComponent::TriggerSkill(uint8 SkillIndex, UGameplaySkillBase*
 {
 	AEODCharacterBase* CharOwner = GetCharacterOwner();
 
-	check(SkillIndexToSkillMap.Contains(SkillIndex));
-	UPlayerSkillBase* PlayerSkill = Skill ? Cast<UPlayerSkillBase>(Skill) : Cast<UPlayerSkillBase>(SkillIndexToSkillMap[SkillIndex]);
+	UPlayerSkillBase* PlayerSkill = Cast<UPlayerSkillBase>(Skill ? Skill : GetSkill(SkillIndex));
 
 	check(PlayerSkill);
 	check(CharOwner);
@@ -325,7 +306,7 @@ void UPlayerSkillsComponent::ReleaseSkill(uint8 SkillIndex, UGameplaySkillBase*
 	AEODCharacterBase* CharOwner = GetCharacterOwner();
 	uint8 ActualSkillIndex = SkillIndex % 100;
 
-	UPlayerSkillBase* PlayerSkill = Skill ? Cast<UPlayerSkillBase>(Skill) : Cast<UPlayerSkillBase>(SkillIndexToSkillMap[ActualSkillIndex]);
+	UPlayerSkillBase* PlayerSkill = Cast<UPlayerSkillBase>(Skill ? Skill : GetSkill(ActualSkillIndex));
 
 	check(PlayerSkill);
 	check(CharOwner);
@@ -450,20 +431,7 @@ TArray<UContainerWidget*> UPlayerSkillsComponent::GetAllContainerWidgetsForSkill
 		return TArray<UContainerWidget*>();
 	}
 
-	int SkillIndex = 0;
-	TArray<uint8> SkillsMapKeys;
-	SkillIndexToSkillMap.GetKeys(SkillsMapKeys);
-
-	for (uint8 Key : SkillsMapKeys)
-	{
-		UGameplaySkillBase* Skill = SkillIndexToSkillMap[Key];
-		if (Skill && Skill->GetSkillGroup() == SkillGroup)
-		{
-			SkillIndex = Key;
-			break;
-		}
-	}
-
+	uint8 SkillIndex = GetSkillIndexForSkillGroup(SkillGroup);
 	if (SkillIndex == 0)
 	{
 		return TArray<UContainerWidget*>();
@@ -515,7 +483,7 @@ void UPlayerSkillsComponent::ActivateChainSkill(UGameplaySkillBase* CurrentSkill
 	}
 
 	uint8 SupersedingSkillIndex = GetSkillIndexForSkillGroup(PlayerSkill->GetSupersedingSkillGroup());
-	UPlayerSkillBase* SupersedingSkill = SkillIndexToSkillMap.Contains(SupersedingSkillIndex) ? Cast<UPlayerSkillBase>(SkillIndexToSkillMap[SupersedingSkillIndex]) : nullptr;
+	UPlayerSkillBase* SupersedingSkill = Cast<UPlayerSkillBase>(GetSkill(SupersedingSkillIndex));
 
 	if (SupersedingSkill)
 	{
@@ -538,28 +506,21 @@ void UPlayerSkillsComponent::OnPlayerWeaponChanged()
 		return;
 	}
 
-	TArray<uint8> Keys;
-	SkillBarMap.GetKeys(Keys);
-
-	for (uint8 Key : Keys)
+	for (const TPair<uint8, uint8>& SkillBarPair : SkillBarMap)
 	{
-		uint8 SkillKey = SkillBarMap[Key];
-		if (SkillIndexToSkillMap.Contains(SkillKey))
+		UPlayerSkillBase* Skill = Cast<UPlayerSkillBase>(GetSkill(SkillBarPair.Value));
+		UContainerWidget* Cont = SkillBarWidget->GetContainerAtIndex(SkillBarPair.Key);
+		if (Skill && Cont)
 		{
-			UPlayerSkillBase* Skill = Cast<UPlayerSkillBase>(SkillIndexToSkillMap[SkillKey]);
-			UContainerWidget* Cont = SkillBarWidget->GetContainerAtIndex(Key);
-			if (Skill && Cont)
+			if (Skill->CanPlayerActivateThisSkill())
 			{
-				if (Skill->CanPlayerActivateThisSkill())
-				{
-					Cont->ItemImage->SetIsEnabled(true);
-					Cont->SetCanBeClicked(true);
-				}
-				else
-				{
-					Cont->ItemImage->SetIsEnabled(false);
-					Cont->SetCanBeClicked(false);
-				}
+				Cont->ItemImage->SetIsEnabled(true);
+				Cont->SetCanBeClicked(true);
+			}
+			else
+			{
+				Cont->ItemImage->SetIsEnabled(false);
+				Cont->SetCanBeClicked(false);
 			}
 		}
 	}
@@ -569,8 +530,8 @@ void UPlayerSkillsComponent::ResetChainSkill()
 {
 	if (SupersedingChainSkillGroup.Value != 0)
 	{
-		check(SkillIndexToSkillMap.Contains(SupersedingChainSkillGroup.Value));
-		UPlayerSkillBase* PlayerSkill = Cast<UPlayerSkillBase>(SkillIndexToSkillMap[SupersedingChainSkillGroup.Value]);
+		UPlayerSkillBase* PlayerSkill = Cast<UPlayerSkillBase>(GetSkill(SupersedingChainSkillGroup.Value));
+		check(PlayerSkill);
 		PlayerSkill->OnDeactivatedAsChainSkill();
 	}
 
@@ -2,11 +2,250 @@
 
 #include "StatsComponentBase.h"
 #include "EOD.h"
+#include "EODGameModeBase.h"
+#include "RegenerationManager.h"
 
 #include "UnrealNetwork.h"
 #include "TimerManager.h"
 #include "Engine/World.h"
 
+/** Primary stat members of UStatsComponentBase, indexed by EStatId */
+static constexpr FPrimaryStat UStatsComponentBase::* const PrimaryStatMembers[] =
+{
+	&UStatsComponentBase::Health,
+	&UStatsComponentBase::Mana,
+	&UStatsComponentBase::Stamina,
+};
+
+/** Generic stat members of UStatsComponentBase, indexed by EStatId minus the number of primary stats */
+static constexpr FGenericStat UStatsComponentBase::* const GenericStatMembers[] =
+{
+	&UStatsComponentBase::HealthRegenRate,
+	&UStatsComponentBase::ManaRegenRate,
+	&UStatsComponentBase::StaminaRegenRate,
+	&UStatsComponentBase::PhysicalAttack,
+	&UStatsComponentBase::MagickalAttack,
+	&UStatsComponentBase::PhysicalResistance,
+	&UStatsComponentBase::MagickalResistance,
+	&UStatsComponentBase::PhysicalCritRate,
+	&UStatsComponentBase::MagickalCritRate,
+	&UStatsComponentBase::PhysicalCritBonus,
+	&UStatsComponentBase::MagickalCritBonus,
+	&UStatsComponentBase::BleedResistance,
+	&UStatsComponentBase::CrowdControlResistance,
+	&UStatsComponentBase::CooldownModifier,
+	&UStatsComponentBase::ExpModifier,
+	&UStatsComponentBase::SpellCastingSpeedModifier,
+	&UStatsComponentBase::StaminaConsumptionModifier,
+	&UStatsComponentBase::PhysicalDamageReductionOnBlock,
+	&UStatsComponentBase::MagickalDamageReductionOnBlock,
+	&UStatsComponentBase::Darkness,
+};
+
+constexpr int32 NumPrimaryStats = ARRAY_COUNT(PrimaryStatMembers);
+
+static_assert(NumPrimaryStats + ARRAY_COUNT(GenericStatMembers) == (uint8)EStatId::Num, "Every stat needs a member in the stat member tables");
+
+constexpr bool AreStatTypesValid()
+{
+	for (int32 i = 0; i < (uint8)EStatId::Num; i++)
+	{
+		if ((StatInfos[i].Type == EStatType::Primary) != (i < NumPrimaryStats))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+static_assert(AreStatTypesValid(), "Primary stats must come first in EStatId");
+
+/** Returns the number of values that stats with ReplicationCondition take in a FStatsReplicationBlock */
+constexpr int32 GetNumReplicatedValues(ELifetimeCondition ReplicationCondition)
+{
+	int32 NumValues = 0;
+	for (const FStatInfo& StatInfo : StatInfos)
+	{
+		if (StatInfo.ReplicationCondition == ReplicationCondition)
+		{
+			NumValues += StatInfo.Type == EStatType::Primary ? 2 : 1;
+		}
+	}
+	return NumValues;
+}
+
+/** Values in UStatsComponentBase::ReplicatedStats. The last value is CC immunities */
+constexpr int32 NumReplicatedValues = GetNumReplicatedValues(COND_None) + 1;
+
+/** Values in UStatsComponentBase::OwnerReplicatedStats */
+constexpr int32 NumOwnerReplicatedValues = GetNumReplicatedValues(COND_OwnerOnly);
+
+static_assert(NumReplicatedValues + NumOwnerReplicatedValues == NumPrimaryStats * 2 + ARRAY_COUNT(GenericStatMembers) + 1,
+	"Stats can only be replicated with COND_None or COND_OwnerOnly");
+
+// The dirty bitmask of a stat block is 64 bits wide
+static_assert(NumReplicatedValues <= 64 && NumOwnerReplicatedValues <= 64, "Too many stats in a FStatsReplicationBlock");
+
+EStatId FindStatIdByName(FName StatName)
+{
+	for (uint8 i = 0; i < (uint8)EStatId::Num; i++)
+	{
+		if (StatName == StatInfos[i].Name)
+		{
+			return (EStatId)i;
+		}
+	}
+	return EStatId::Num;
+}
+
+/** Per connection state of a FStatsReplicationBlock, i.e., the values that were last sent to the connection */
+class FStatsReplicationBlockBaseState : public INetDeltaBaseState
+{
+public:
+
+	virtual bool IsStateEqual(INetDeltaBaseState* OtherState) override
+	{
+		return QuantizedValues == static_cast<FStatsReplicationBlockBaseState*>(OtherState)->QuantizedValues;
+	}
+
+	TArray<int32> QuantizedValues;
+
+};
+
+bool FStatsReplicationBlock::NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms)
+{
+	if (DeltaParms.Writer)
+	{
+		FBitWriter& Writer = *DeltaParms.Writer;
+		FStatsReplicationBlockBaseState* OldState = static_cast<FStatsReplicationBlockBaseState*>(DeltaParms.OldState);
+		check(QuantizedValues.Num() <= 64);
+		const bool bFullState = OldState == nullptr || OldState->QuantizedValues.Num() != QuantizedValues.Num();
+
+		uint64 DirtyMask = 0;
+		for (int32 i = 0; i < QuantizedValues.Num(); i++)
+		{
+			if (bFullState || OldState->QuantizedValues[i] != QuantizedValues[i])
+			{
+				DirtyMask |= (uint64)1 << i;
+			}
+		}
+
+		FStatsReplicationBlockBaseState* NewState = new FStatsReplicationBlockBaseState();
+		NewState->QuantizedValues = QuantizedValues;
+		*DeltaParms.NewState = MakeShareable(NewState);
+
+		if (DirtyMask == 0)
+		{
+			return false;
+		}
+
+		uint32 NumValues = QuantizedValues.Num();
+		Writer.SerializeIntPacked(NumValues);
+		Writer.SerializeBits(&DirtyMask, NumValues);
+		for (int32 i = 0; i < QuantizedValues.Num(); i++)
+		{
+			if (DirtyMask & ((uint64)1 << i))
+			{
+				// Zigzag encode so that small negative values stay small when packed
+				uint32 Packed = ((uint32)QuantizedValues[i] << 1) ^ (uint32)(QuantizedValues[i] >> 31);
+				Writer.SerializeIntPacked(Packed);
+			}
+		}
+	}
+	else if (DeltaParms.Reader)
+	{
+		FBitReader& Reader = *DeltaParms.Reader;
+
+		uint32 NumValues = 0;
+		Reader.SerializeIntPacked(NumValues);
+		if (NumValues > 64)
+		{
+			Reader.SetError();
+			return false;
+		}
+		if (QuantizedValues.Num() != (int32)NumValues)
+		{
+			SetNum(NumValues);
+		}
+
+		uint64 DirtyMask = 0;
+		Reader.SerializeBits(&DirtyMask, NumValues);
+		for (int32 i = 0; i < QuantizedValues.Num(); i++)
+		{
+			if (DirtyMask & ((uint64)1 << i))
+			{
+				uint32 Packed = 0;
+				Reader.SerializeIntPacked(Packed);
+				QuantizedValues[i] = (int32)(Packed >> 1) ^ -(int32)(Packed & 1);
+			}
+		}
+
+		return !Reader.IsError();
+	}
+
+	// GUID management calls (e.g. UpdateUnmappedObjects) have neither a writer nor a reader. The block holds no object references,
+	// so there are never any unmapped GUIDs to handle.
+	return false;
+}
+
+static_assert((uint8)EStatId::Num < 32, "FStatsSnapshot::Diff returns a 32 bit mask");
+static_assert(TIsPODType<FStatsSnapshot>::Value, "FStatsSnapshot should stay a plain struct");
+
+uint32 FStatsSnapshot::Diff(const FStatsSnapshot& Other) const
+{
+	uint32 DiffMask = 0;
+	for (uint8 i = 0; i < (uint8)EStatId::Num; i++)
+	{
+		const bool bDiffers = Values[i] != Other.Values[i] || CurrentValues[i] != Other.CurrentValues[i];
+		DiffMask |= (uint32)bDiffers << i;
+	}
+
+	if (CCImmunities != Other.CCImmunities)
+	{
+		DiffMask |= CCImmunitiesDiffBit;
+	}
+	return DiffMask;
+}
+
+FString FStatsSnapshot::DiffToString(const FStatsSnapshot& Other) const
+{
+	const uint32 DiffMask = Diff(Other);
+
+	FString Result;
+	auto AppendChange = [&Result](const FString& Change)
+	{
+		if (!Result.IsEmpty())
+		{
+			Result += TEXT(", ");
+		}
+		Result += Change;
+	};
+
+	for (uint8 i = 0; i < (uint8)EStatId::Num; i++)
+	{
+		if (!(DiffMask & (1u << i)))
+		{
+			continue;
+		}
+
+		if (StatInfos[i].Type == EStatType::Primary)
+		{
+			AppendChange(FString::Printf(TEXT("%s: %.0f/%.0f -> %.0f/%.0f"), StatInfos[i].Name, CurrentValues[i], Values[i], Other.CurrentValues[i], Other.Values[i]));
+		}
+		else
+		{
+			AppendChange(FString::Printf(TEXT("%s: %.2f -> %.2f"), StatInfos[i].Name, Values[i], Other.Values[i]));
+		}
+	}
+
+	if (DiffMask & CCImmunitiesDiffBit)
+	{
+		AppendChange(FString::Printf(TEXT("CCImmunities: 0x%02x -> 0x%02x"), CCImmunities, Other.CCImmunities));
+	}
+	return Result;
+}
+
+
 UStatsComponentBase::UStatsComponentBase(const FObjectInitializer& ObjectInitializer) :
 	Super(ObjectInitializer),
 	Health(100, 100),
@@ -33,48 +272,57 @@ UStatsComponentBase::UStatsComponentBase(const FObjectInitializer& ObjectInitial
 	SpellCastingSpeedModifier(1.f),
 	StaminaConsumptionModifier(1.f),
 	PhysicalDamageReductionOnBlock(10.f),
-	MagickalDamageReductionOnBlock(10.f)
+	MagickalDamageReductionOnBlock(10.f),
+	StatTransactionDepth(0)
 {
 	// This compnent doesn't tick
 	PrimaryComponentTick.bCanEverTick = false;
 	SetIsReplicated(true);
 
+	ReplicatedStats.SetNum(NumReplicatedValues);
+	OwnerReplicatedStats.SetNum(NumOwnerReplicatedValues);
+
 }
 
 void UStatsComponentBase::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
 {
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
 
-	DOREPLIFETIME(UStatsComponentBase, Health);
-	DOREPLIFETIME(UStatsComponentBase, Mana);
-	DOREPLIFETIME(UStatsComponentBase, Stamina);
-
+	DOREPLIFETIME(UStatsComponentBase, ReplicatedStats);
+	DOREPLIFETIME_CONDITION(UStatsComponentBase, OwnerReplicatedStats, COND_OwnerOnly);
 
-	DOREPLIFETIME_CONDITION(UStatsComponentBase, HealthRegenRate, COND_OwnerOnly);
-	DOREPLIFETIME_CONDITION(UStatsComponentBase, ManaRegenRate, COND_OwnerOnly);
-	DOREPLIFETIME_CONDITION(UStatsComponentBase, StaminaRegenRate, COND_OwnerOnly);
-
-	DOREPLIFETIME(UStatsComponentBase, PhysicalAttack);
-	DOREPLIFETIME(UStatsComponentBase, MagickalAttack);
-	DOREPLIFETIME(UStatsComponentBase, PhysicalResistance);
-	DOREPLIFETIME(UStatsComponentBase, MagickalResistance);
-	DOREPLIFETIME(UStatsComponentBase, PhysicalCritRate);
-	DOREPLIFETIME(UStatsComponentBase, MagickalCritRate);
-	DOREPLIFETIME(UStatsComponentBase, PhysicalCritBonus);
-	DOREPLIFETIME(UStatsComponentBase, MagickalCritBonus);
+}
 
-	DOREPLIFETIME(UStatsComponentBase, BleedResistance);
-	DOREPLIFETIME(UStatsComponentBase, CrowdControlResistance);
-	DOREPLIFETIME(UStatsComponentBase, CooldownModifier);
-	DOREPLIFETIME(UStatsComponentBase, ExpModifier);
-	DOREPLIFETIME(UStatsComponentBase, SpellCastingSpeedModifier);
-	DOREPLIFETIME(UStatsComponentBase, StaminaConsumptionModifier);
+void UStatsComponentBase::PreReplication(IRepChangedPropertyTracker& ChangedPropertyTracker)
+{
+	Super::PreReplication(ChangedPropertyTracker);
 
-	DOREPLIFETIME(UStatsComponentBase, PhysicalDamageReductionOnBlock);
-	DOREPLIFETIME(UStatsComponentBase, MagickalDamageReductionOnBlock);
+	// Stats are in the middle of a transaction until it's committed, so wait for it
+	if (IsInStatTransaction())
+	{
+		return;
+	}
 
-	DOREPLIFETIME(UStatsComponentBase, CCImmunities);
-	DOREPLIFETIME(UStatsComponentBase, Darkness);
+	int32 ValueIndex = 0;
+	int32 OwnerValueIndex = 0;
+	for (uint8 i = 0; i < (uint8)EStatId::Num; i++)
+	{
+		const bool bOwnerOnly = StatInfos[i].ReplicationCondition == COND_OwnerOnly;
+		FStatsReplicationBlock& Block = bOwnerOnly ? OwnerReplicatedStats : ReplicatedStats;
+		int32& Index = bOwnerOnly ? OwnerValueIndex : ValueIndex;
+
+		if (i < NumPrimaryStats)
+		{
+			const FPrimaryStat& Stat = this->*PrimaryStatMembers[i];
+			Block.SetInt(Index++, Stat.GetMaxValue());
+			Block.SetInt(Index++, Stat.GetCurrentValue());
+		}
+		else
+		{
+			Block.SetFloat(Index++, (this->*GenericStatMembers[i - NumPrimaryStats]).GetValue());
+		}
+	}
+	ReplicatedStats.SetInt(ValueIndex, CCImmunities.GetImmunityMask());
 
 }
 
@@ -107,25 +355,224 @@ void UStatsComponentBase::BeginPlay()
 	//~ @todo Load stat values
 }
 
+void UStatsComponentBase::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	DeactivateHealthRegeneration();
+	DeactivateManaRegeneration();
+	DeactivateStaminaRegeneration();
+
+	Super::EndPlay(EndPlayReason);
+}
+
 void UStatsComponentBase::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
 {
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
 
 }
 
-void UStatsComponentBase::OnRep_Health()
+template<typename PrimaryStatFuncType, typename GenericStatFuncType>
+void UStatsComponentBase::ForEachStat(PrimaryStatFuncType PrimaryStatFunc, GenericStatFuncType GenericStatFunc)
+{
+	for (FPrimaryStat UStatsComponentBase::* StatMember : PrimaryStatMembers)
+	{
+		PrimaryStatFunc(this->*StatMember);
+	}
+
+	for (FGenericStat UStatsComponentBase::* StatMember : GenericStatMembers)
+	{
+		GenericStatFunc(this->*StatMember);
+	}
+}
+
+template<typename PrimaryStatFuncType, typename GenericStatFuncType>
+void UStatsComponentBase::ForEachStat(PrimaryStatFuncType PrimaryStatFunc, GenericStatFuncType GenericStatFunc) const
+{
+	for (FPrimaryStat UStatsComponentBase::* StatMember : PrimaryStatMembers)
+	{
+		PrimaryStatFunc(this->*StatMember);
+	}
+
+	for (FGenericStat UStatsComponentBase::* StatMember : GenericStatMembers)
+	{
+		GenericStatFunc(this->*StatMember);
+	}
+}
+
+void UStatsComponentBase::BeginStatTransaction()
+{
+	if (StatTransactionDepth++ == 0)
+	{
+		ForEachStat(
+			[](FPrimaryStat& Stat) { Stat.BeginDeferredUpdates(); },
+			[](FGenericStat& Stat) { Stat.BeginDeferredUpdates(); });
+	}
+}
+
+void UStatsComponentBase::CommitStatTransaction()
+{
+	check(StatTransactionDepth > 0);
+	if (--StatTransactionDepth == 0)
+	{
+		ForEachStat(
+			[](FPrimaryStat& Stat) { Stat.EndDeferredUpdates(); },
+			[](FGenericStat& Stat) { Stat.EndDeferredUpdates(); });
+	}
+}
+
+FStatsSnapshot UStatsComponentBase::CaptureSnapshot() const
+{
+	FStatsSnapshot Snapshot;
+
+	// Stats are visited in the order of EStatId
+	int32 StatIndex = 0;
+	ForEachStat(
+		[&](const FPrimaryStat& Stat)
+		{
+			Snapshot.Values[StatIndex] = Stat.GetMaxValue();
+			Snapshot.CurrentValues[StatIndex] = Stat.GetCurrentValue();
+			StatIndex++;
+		},
+		[&](const FGenericStat& Stat)
+		{
+			Snapshot.Values[StatIndex] = Stat.GetValue();
+			Snapshot.CurrentValues[StatIndex] = Stat.GetValue();
+			StatIndex++;
+		});
+	check(StatIndex == (uint8)EStatId::Num);
+
+	Snapshot.CCImmunities = CCImmunities.GetImmunityMask();
+	return Snapshot;
+}
+
+
+void UStatsComponentBase::OnRep_ReplicatedStats()
+{
+	OnRepStatBlock(COND_None);
+}
+
+void UStatsComponentBase::OnRep_OwnerReplicatedStats()
+{
+	OnRepStatBlock(COND_OwnerOnly);
+}
+
+void UStatsComponentBase::OnRepStatBlock(ELifetimeCondition ReplicationCondition)
+{
+	const bool bOwnerOnly = ReplicationCondition == COND_OwnerOnly;
+	const FStatsReplicationBlock& Block = bOwnerOnly ? OwnerReplicatedStats : ReplicatedStats;
+	if (Block.Num() != (bOwnerOnly ? NumOwnerReplicatedValues : NumReplicatedValues))
+	{
+		return;
+	}
+
+	// Apply all values at once so each stat broadcasts a single change
+	FScopedStatTransaction StatTransaction(this);
+
+	int32 Index = 0;
+	for (uint8 i = 0; i < (uint8)EStatId::Num; i++)
+	{
+		if (StatInfos[i].ReplicationCondition != ReplicationCondition)
+		{
+			continue;
+		}
+
+		if (i < NumPrimaryStats)
+		{
+			const int32 MaxValue = Block.GetInt(Index++);
+			const int32 CurrentValue = Block.GetInt(Index++);
+			(this->*PrimaryStatMembers[i]).SetReplicatedValues(MaxValue, CurrentValue);
+		}
+		else
+		{
+			(this->*GenericStatMembers[i - NumPrimaryStats]).SetReplicatedValue(Block.GetFloat(Index++));
+		}
+	}
+
+	if (!bOwnerOnly)
+	{
+		CCImmunities.SetReplicatedValue((uint8)Block.GetInt(Index));
+	}
+}
+
+FPrimaryStat* UStatsComponentBase::GetPrimaryStat(EStatId StatId)
+{
+	return (uint8)StatId < NumPrimaryStats ? &(this->*PrimaryStatMembers[(uint8)StatId]) : nullptr;
+}
+
+FGenericStat* UStatsComponentBase::GetGenericStat(EStatId StatId)
+{
+	return (uint8)StatId >= NumPrimaryStats && StatId < EStatId::Num ? &(this->*GenericStatMembers[(uint8)StatId - NumPrimaryStats]) : nullptr;
+}
+
+void UStatsComponentBase::SetStatBaseValue(EStatId StatId, float InValue)
+{
+	if (StatId >= EStatId::Num)
+	{
+		return;
+	}
+
+	const FStatInfo& StatInfo = GetStatInfo(StatId);
+	const float Value = FMath::Clamp(InValue, StatInfo.MinBaseValue, StatInfo.MaxBaseValue);
+	if (FPrimaryStat* PrimaryStat = GetPrimaryStat(StatId))
+	{
+		PrimaryStat->SetMaxValue(FMath::TruncToInt(Value));
+	}
+	else
+	{
+		GetGenericStat(StatId)->SetValue(Value);
+	}
+}
+
+float UStatsComponentBase::GetStatValue(EStatId StatId)
+{
+	if (FPrimaryStat* PrimaryStat = GetPrimaryStat(StatId))
+	{
+		return PrimaryStat->GetMaxValue();
+	}
+	FGenericStat* GenericStat = GetGenericStat(StatId);
+	return GenericStat ? GenericStat->GetValue() : 0.f;
+}
+
+void UStatsComponentBase::AddStatModifier(EStatId StatId, uint32 SourceID, const FStatModifier& Modifier)
 {
-	Health.ForceBroadcastDelegate();
+	if (FPrimaryStat* PrimaryStat = GetPrimaryStat(StatId))
+	{
+		PrimaryStat->AddModifier(SourceID, Modifier);
+	}
+	else if (FGenericStat* GenericStat = GetGenericStat(StatId))
+	{
+		GenericStat->AddModifier(SourceID, Modifier);
+	}
 }
 
-void UStatsComponentBase::OnRep_Mana()
+void UStatsComponentBase::RemoveStatModifier(EStatId StatId, uint32 SourceID)
 {
-	Mana.ForceBroadcastDelegate();
+	if (FPrimaryStat* PrimaryStat = GetPrimaryStat(StatId))
+	{
+		PrimaryStat->RemoveModifier(SourceID);
+	}
+	else if (FGenericStat* GenericStat = GetGenericStat(StatId))
+	{
+		GenericStat->RemoveModifier(SourceID);
+	}
 }
 
-void UStatsComponentBase::OnRep_Stamina()
+void UStatsComponentBase::AddStatModifiers(uint32 SourceID, TArrayView<const FStatModifierEntry> ModifierEntries)
 {
-	Stamina.ForceBroadcastDelegate();
+	FScopedStatTransaction StatTransaction(this);
+
+	for (const FStatModifierEntry& Entry : ModifierEntries)
+	{
+		AddStatModifier(Entry.StatId, SourceID, Entry.Modifier);
+	}
+}
+
+void UStatsComponentBase::RemoveAllStatModifiers(uint32 SourceID)
+{
+	FScopedStatTransaction StatTransaction(this);
+
+	ForEachStat(
+		[SourceID](FPrimaryStat& Stat) { Stat.RemoveModifier(SourceID); },
+		[SourceID](FGenericStat& Stat) { Stat.RemoveModifier(SourceID); });
 }
 
 bool UStatsComponentBase::IsLowOnHealth()
@@ -159,8 +606,23 @@ void UStatsComponentBase::OnStaminaChanged(int32 MaxValue, int32 CurrentValue)
 	}
 }
 
+ARegenerationManager* UStatsComponentBase::GetRegenerationManager() const
+{
+	UWorld* World = GetWorld();
+	AEODGameModeBase* GameMode = World ? Cast<AEODGameModeBase>(World->GetAuthGameMode()) : nullptr;
+	return GameMode ? GameMode->GetRegenerationManager() : nullptr;
+}
+
 void UStatsComponentBase::ActivateHealthRegeneration()
 {
+	ARegenerationManager* RegenerationManager = GetRegenerationManager();
+	if (RegenerationManager && HealthRegenTickInterval > 0.f)
+	{
+		RegenerationManager->StartRegeneration(this, ERegeneratingStat::Health, HealthRegenTickInterval);
+		bIsRegeneratingHealth = true;
+		return;
+	}
+
 	UWorld* World = GetWorld();
 	if (World && HealthRegenTickInterval > 0.f)
 	{
@@ -175,6 +637,14 @@ void UStatsComponentBase::ActivateHealthRegeneration()
 
 void UStatsComponentBase::ActivateManaRegeneration()
 {
+	ARegenerationManager* RegenerationManager = GetRegenerationManager();
+	if (RegenerationManager && ManaRegenTickInterval > 0.f)
+	{
+		RegenerationManager->StartRegeneration(this, ERegeneratingStat::Mana, ManaRegenTickInterval);
+		bIsRegeneratingMana = true;
+		return;
+	}
+
 	UWorld* World = GetWorld();
 	if (World && ManaRegenTickInterval > 0.f)
 	{
@@ -189,6 +659,14 @@ void UStatsComponentBase::ActivateManaRegeneration()
 
 void UStatsComponentBase::ActivateStaminaRegeneration()
 {
+	ARegenerationManager* RegenerationManager = GetRegenerationManager();
+	if (RegenerationManager && StaminaRegenTickInterval > 0.f)
+	{
+		RegenerationManager->StartRegeneration(this, ERegeneratingStat::Stamina, StaminaRegenTickInterval);
+		bIsRegeneratingStamina = true;
+		return;
+	}
+
 	UWorld* World = GetWorld();
 	if (World && StaminaRegenTickInterval > 0.f)
 	{
@@ -203,6 +681,12 @@ void UStatsComponentBase::ActivateStaminaRegeneration()
 
 void UStatsComponentBase::DeactivateHealthRegeneration()
 {
+	ARegenerationManager* RegenerationManager = GetRegenerationManager();
+	if (RegenerationManager && bIsRegeneratingHealth)
+	{
+		RegenerationManager->StopRegeneration(this, ERegeneratingStat::Health);
+	}
+
 	UWorld* World = GetWorld();
 	if (World)
 	{
@@ -213,6 +697,12 @@ void UStatsComponentBase::DeactivateHealthRegeneration()
 
 void UStatsComponentBase::DeactivateManaRegeneration()
 {
+	ARegenerationManager* RegenerationManager = GetRegenerationManager();
+	if (RegenerationManager && bIsRegeneratingMana)
+	{
+		RegenerationManager->StopRegeneration(this, ERegeneratingStat::Mana);
+	}
+
 	UWorld* World = GetWorld();
 	if (World)
 	{
@@ -223,6 +713,12 @@ void UStatsComponentBase::DeactivateManaRegeneration()
 
 void UStatsComponentBase::DeactivateStaminaRegeneration()
 {
+	ARegenerationManager* RegenerationManager = GetRegenerationManager();
+	if (RegenerationManager && bIsRegeneratingStamina)
+	{
+		RegenerationManager->StopRegeneration(this, ERegeneratingStat::Stamina);
+	}
+
 	UWorld* World = GetWorld();
 	if (World)
 	{
@@ -21,6 +21,9 @@
 #include "AISkillBase.h"
 #include "EODWidgetComponent.h"
 #include "DamageNumberWidget.h"
+#include "CombatZoneModeBase.h"
+#include "CombatManager.h"
+#include "DamageCalculator.h"
 
 #include "IdleWalkRunState.h"
 #include "DeadState.h"
@@ -37,6 +40,7 @@
 #include "Camera/CameraComponent.h"
 #include "Components/CapsuleComponent.h"
 #include "Components/AudioComponent.h"
+#include "Components/SkeletalMeshComponent.h"
 
 /**
  * EOD Character stats
@@ -123,6 +127,12 @@ void AEODCharacterBase::Tick(float DeltaTime)
 
 	ResetTickDependentData();
 
+	// Lag compensation is only needed when there are remote clients to compensate for
+	if (Role == ROLE_Authority && GetNetMode() != NM_Standalone && GetMesh())
+	{
+		TransformHistory.Record(GetWorld()->GetTimeSeconds(), GetMesh()->GetComponentTransform());
+	}
+
 	if (Controller && Controller->IsLocalPlayerController())
 	{
 		bool bCanGuardAgainstAttacks = CanGuardAgainstAttacks();
@@ -186,20 +196,46 @@ void AEODCharacterBase::BeginPlay()
 		MoveComp->SetDesiredCustomRotation(GetActorRotation());
 	}
 
+	// Game mode only exists on server, so characters are only registered for spatial queries on server
+	UWorld* World = GetWorld();
+	ACombatZoneModeBase* CombatZoneGameMode = World ? Cast<ACombatZoneModeBase>(World->GetAuthGameMode()) : nullptr;
+	ACombatManager* CombatManager = CombatZoneGameMode ? CombatZoneGameMode->GetCombatManager() : nullptr;
+	if (CombatManager)
+	{
+		CombatManager->RegisterCharacter(this);
+	}
+}
 
+void AEODCharacterBase::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	UWorld* World = GetWorld();
+	ACombatZoneModeBase* CombatZoneGameMode = World ? Cast<ACombatZoneModeBase>(World->GetAuthGameMode()) : nullptr;
+	ACombatManager* CombatManager = CombatZoneGameMode ? CombatZoneGameMode->GetCombatManager() : nullptr;
+	if (CombatManager)
+	{
+		CombatManager->UnregisterCharacter(this);
+	}
 
+	Super::EndPlay(EndPlayReason);
 }
 
 void AEODCharacterBase::PostInitializeComponents()
 {
 	Super::PostInitializeComponents();
 
+	// Faction is only known after blueprint defaults have been applied, so the bodies are tagged here rather than in constructor
+	UpdateFactionMaskFilter();
+
 }
 
 void AEODCharacterBase::PossessedBy(AController* NewController)
 {
 	Super::PossessedBy(NewController);
 
+	// Stats are owned by the controller, so the normal attack cache is only valid for the controller that was used to build it
+	InvalidateNormalAttackInfoCache();
+	BindNormalAttackStatDelegates(GetStatsComponent());
+
 	// @todo - Enable interaction sphere on client.
 	if (NewController && NewController->IsLocalPlayerController())
 	{
@@ -213,6 +249,9 @@ void AEODCharacterBase::PossessedBy(AController* NewController)
 
 void AEODCharacterBase::UnPossessed()
 {
+	UnbindNormalAttackStatDelegates(GetStatsComponent());
+	InvalidateNormalAttackInfoCache();
+
 	Super::UnPossessed();
 }
 
@@ -426,16 +465,31 @@ bool AEODCharacterBase::IsHealing() const
 }
 
 bool AEODCharacterBase::CCEFlinch(const float BCAngle)
+{
+	return CanReceiveCCE(ECrowdControlEffect::Flinch) && ApplyFlinch(BCAngle);
+}
+
+bool AEODCharacterBase::ApplyFlinch(const float BCAngle)
 {
 	return false;
 }
 
 bool AEODCharacterBase::CCEInterrupt(const float BCAngle)
+{
+	return CanReceiveCCE(ECrowdControlEffect::Interrupt) && ApplyInterrupt(BCAngle);
+}
+
+bool AEODCharacterBase::ApplyInterrupt(const float BCAngle)
 {
 	return false;
 }
 
 bool AEODCharacterBase::CCEStun(const float Duration)
+{
+	return CanReceiveCCE(ECrowdControlEffect::Stunned) && ApplyStun(Duration);
+}
+
+bool AEODCharacterBase::ApplyStun(const float Duration)
 {
 	return false;
 }
@@ -445,6 +499,11 @@ void AEODCharacterBase::CCERemoveStun()
 }
 
 bool AEODCharacterBase::CCEFreeze(const float Duration)
+{
+	return CanReceiveCCE(ECrowdControlEffect::Crystalized) && ApplyFreeze(Duration);
+}
+
+bool AEODCharacterBase::ApplyFreeze(const float Duration)
 {
 	return false;
 }
@@ -454,6 +513,11 @@ void AEODCharacterBase::CCEUnfreeze()
 }
 
 bool AEODCharacterBase::CCEKnockdown(const float Duration)
+{
+	return CanReceiveCCE(ECrowdControlEffect::KnockedDown) && ApplyKnockdown(Duration);
+}
+
+bool AEODCharacterBase::ApplyKnockdown(const float Duration)
 {
 	return false;
 }
@@ -462,7 +526,12 @@ void AEODCharacterBase::CCEEndKnockdown()
 {
 }
 
-bool AEODCharacterBase::CCEKnockback(const float Duration, const FVector & ImpulseDirection)
+bool AEODCharacterBase::CCEKnockback(const float Duration, const FVector& ImpulseDirection)
+{
+	return CanReceiveCCE(ECrowdControlEffect::KnockedBack) && ApplyKnockback(Duration, ImpulseDirection);
+}
+
+bool AEODCharacterBase::ApplyKnockback(const float Duration, const FVector& ImpulseDirection)
 {
 	return false;
 }
@@ -471,7 +540,7 @@ void AEODCharacterBase::PushBack_Implementation(const FVector& ImpulseDirection)
 {
 }
 
-void AEODCharacterBase::DodgeAttack(AActor* HitInstigator, ICombatInterface* InstigatorCI, const TSharedPtr<FAttackInfo>& AttackInfoPtr)
+void AEODCharacterBase::DodgeAttack(AActor* HitInstigator, ICombatInterface* InstigatorCI, const FAttackInfo& AttackInfo)
 {
 	UAttackDodgedEvent* DodgeEvent = NewObject<UAttackDodgedEvent>(this, UAttackDodgedEvent::StaticClass(), FName("DodgeEvent"), RF_Transient);
 	DodgeEvent->AddToRoot();
@@ -480,7 +549,7 @@ void AEODCharacterBase::DodgeAttack(AActor* HitInstigator, ICombatInterface* Ins
 	DodgeEvent->MarkPendingKill();
 }
 
-void AEODCharacterBase::BlockAttack(AActor* HitInstigator, ICombatInterface* InstigatorCI, const TSharedPtr<FAttackInfo>& AttackInfoPtr)
+void AEODCharacterBase::BlockAttack(AActor* HitInstigator, ICombatInterface* InstigatorCI, const FAttackInfo& AttackInfo)
 {
 	//~ @todo block event
 	PlayAttackBlockedAnimation();
@@ -586,34 +655,34 @@ AActor* AEODCharacterBase::GetInterfaceOwner()
 	return this;
 }
 
-TSharedPtr<FAttackInfo> AEODCharacterBase::GetAttackInfoPtr(const FName& SkillGroup, const int32 CollisionIndex)
+bool AEODCharacterBase::GetAttackInfo(const FName& SkillGroup, const int32 CollisionIndex, FAttackInfo& OutAttackInfo)
 {
-	UGameplaySkillBase* Skill = SkillManager ? SkillManager->GetSkillForSkillGroup(SkillGroup) : nullptr;
-	TSharedPtr<FAttackInfo> AttackInfoPtr = Skill ? Skill->GetAttackInfoPtr(CollisionIndex) : TSharedPtr<FAttackInfo>();
-	return AttackInfoPtr;
+	return SkillManager ? SkillManager->GetAttackInfo(SkillGroup, CollisionIndex, OutAttackInfo) : false;
 }
 
-TSharedPtr<FAttackResponse> AEODCharacterBase::ReceiveAttack(
+bool AEODCharacterBase::ReceiveAttack(
 	AActor* HitInstigator,
 	ICombatInterface* InstigatorCI,
-	const TSharedPtr<FAttackInfo>& AttackInfoPtr,
+	const FAttackInfo& AttackInfo,
 	const FHitResult& DirectHitResult,
 	const bool bLineHitResultFound,
-	const FHitResult& LineHitResult)
+	const FHitResult& LineHitResult,
+	FAttackResponse& OutAttackResponse,
+	const FDamageOutcome* PrecomputedDamage)
 {
 	UStatsComponentBase* StatsComp = GetStatsComponent();
-	if (!StatsComp || !InstigatorCI || !AttackInfoPtr.IsValid())
+	if (!StatsComp || !InstigatorCI)
 	{
-		return TSharedPtr<FAttackResponse>();
+		return false;
 	}
 
 	FReceivedHitInfo ReceivedHitInfo;
 	ReceivedHitInfo.HitInstigator = HitInstigator;
 
 	// Handle dodge
-	if (!AttackInfoPtr->bUndodgable && this->IsDodgingDamage())
+	if (!AttackInfo.bUndodgable && this->IsDodgingDamage())
 	{
-		DodgeAttack(HitInstigator, InstigatorCI, AttackInfoPtr);
+		DodgeAttack(HitInstigator, InstigatorCI, AttackInfo);
 
 		// Replicate Hit Info
 		ReceivedHitInfo.DamageResult = EDamageResult::Dodged;
@@ -621,15 +690,15 @@ TSharedPtr<FAttackResponse> AEODCharacterBase::ReceiveAttack(
 		SetLastReceivedHitInfo(ReceivedHitInfo);
 
 
-		TSharedPtr<FAttackResponse> AttackResponsePtr = TSharedPtr<FAttackResponse>(new FAttackResponse);
-		AttackResponsePtr->DamageResult = EDamageResult::Dodged;
-		return AttackResponsePtr;
+		OutAttackResponse = FAttackResponse();
+		OutAttackResponse.DamageResult = EDamageResult::Dodged;
+		return true;
 	}
 
 	//~ possible alternative to current damage blocking
 	/*
 	bool bAttackBlocked = false;
-	if (!AttackInfoPtr->bUnblockable && this->IsBlockingDamage())
+	if (!AttackInfo.bUnblockable && this->IsBlockingDamage())
 	{
 		const FVector& HIVec = HitInstigator->GetActorForwardVector();
 		const FVector& ForVec = this->GetActorForwardVector();
@@ -642,18 +711,30 @@ TSharedPtr<FAttackResponse> AEODCharacterBase::ReceiveAttack(
 	}
 	*/
 
-	ReceivedHitInfo.bCritHit = AttackInfoPtr->CritRate >= FMath::RandRange(0.f, 100.f) ? true : false;
+	if (PrecomputedDamage)
+	{
+		ReceivedHitInfo.bCritHit = PrecomputedDamage->bCritHit;
+	}
+	else
+	{
+		UWorld* World = GetWorld();
+		ACombatZoneModeBase* CombatZoneGameMode = World ? Cast<ACombatZoneModeBase>(World->GetAuthGameMode()) : nullptr;
+		ACombatManager* CombatManager = CombatZoneGameMode ? CombatZoneGameMode->GetCombatManager() : nullptr;
+
+		const float CritRoll = CombatManager ? FDamageCalculator::RollCrit(CombatManager->GetCombatRandom().NextAttackStream()) : FMath::FRandRange(0.f, 100.f);
+		ReceivedHitInfo.bCritHit = FDamageCalculator::IsCritRoll(AttackInfo.CritRate, CritRoll);
+	}
 
 	bool bAttackBlocked = false;
 	if (bLineHitResultFound)
 	{
 		ReceivedHitInfo.BCAngle = UEODBlueprintFunctionLibrary::CalculateAngleBetweenVectors(GetActorForwardVector(), LineHitResult.ImpactNormal);
-		if (!AttackInfoPtr->bUnblockable && this->IsBlockingDamage())
+		if (!AttackInfo.bUnblockable && this->IsBlockingDamage())
 		{
 			bAttackBlocked = ReceivedHitInfo.BCAngle < UCombatLibrary::BlockDetectionAngle ? true : false;
 			if (bAttackBlocked)
 			{
-				BlockAttack(HitInstigator, InstigatorCI, AttackInfoPtr);
+				BlockAttack(HitInstigator, InstigatorCI, AttackInfo);
 				ReceivedHitInfo.DamageResult = EDamageResult::Blocked;
 			}
 		}
@@ -665,14 +746,17 @@ TSharedPtr<FAttackResponse> AEODCharacterBase::ReceiveAttack(
 
 	bool bCCEApplied = ApplyCCE(
 		HitInstigator,
-		AttackInfoPtr->CrowdControlEffect,
-		AttackInfoPtr->CrowdControlEffectDuration,
+		AttackInfo.CrowdControlEffect,
+		AttackInfo.CrowdControlEffectDuration,
 		ReceivedHitInfo.BCAngle,
 		bAttackBlocked);
 
-	ReceivedHitInfo.CrowdControlEffect = bCCEApplied ? AttackInfoPtr->CrowdControlEffect : ECrowdControlEffect::Flinch;
-	ReceivedHitInfo.CrowdControlEffectDuration = AttackInfoPtr->CrowdControlEffectDuration;
-	ReceivedHitInfo.ActualDamage = GetActualDamage(HitInstigator, InstigatorCI, AttackInfoPtr, ReceivedHitInfo.bCritHit, bAttackBlocked);
+	ReceivedHitInfo.CrowdControlEffect = bCCEApplied ? AttackInfo.CrowdControlEffect : ECrowdControlEffect::Flinch;
+	ReceivedHitInfo.CrowdControlEffectDuration = AttackInfo.CrowdControlEffectDuration;
+	ReceivedHitInfo.ActualDamage =
+		PrecomputedDamage ?
+		PrecomputedDamage->GetDamage(bAttackBlocked) :
+		GetActualDamage(HitInstigator, InstigatorCI, AttackInfo, ReceivedHitInfo.bCritHit, bAttackBlocked);
 
 	if (!bAttackBlocked && ReceivedHitInfo.ActualDamage == 0)
 	{
@@ -686,7 +770,7 @@ TSharedPtr<FAttackResponse> AEODCharacterBase::ReceiveAttack(
 		ReceivedHitInfo.HitSurface = PhysMat->SurfaceType;
 	}
 
-	ReceivedHitInfo.CamShakeType = AttackInfoPtr->CamShakeType;
+	ReceivedHitInfo.CamShakeType = AttackInfo.CamShakeType;
 
 	ReceivedHitInfo.ReplicationIndex = GetLastReceivedHitInfo().ReplicationIndex + 1;
 	SetLastReceivedHitInfo(ReceivedHitInfo);
@@ -694,61 +778,30 @@ TSharedPtr<FAttackResponse> AEODCharacterBase::ReceiveAttack(
 	StatsComp->Health.ModifyCurrentValue(-ReceivedHitInfo.ActualDamage);
 	TriggerReceivedHitCosmetics(ReceivedHitInfo);
 
-	TSharedPtr<FAttackResponse> AttackResponsePtr = 
-		TSharedPtr<FAttackResponse>(
-			new FAttackResponse(
-				ReceivedHitInfo.DamageResult,
-				ReceivedHitInfo.CrowdControlEffect,
-				ReceivedHitInfo.ActualDamage,
-				ReceivedHitInfo.bCritHit
-			));
+	OutAttackResponse = FAttackResponse(
+		ReceivedHitInfo.DamageResult,
+		ReceivedHitInfo.CrowdControlEffect,
+		ReceivedHitInfo.ActualDamage,
+		ReceivedHitInfo.bCritHit);
 
-	return AttackResponsePtr;
+	return true;
 }
 
 float AEODCharacterBase::GetActualDamage(
 	AActor* HitInstigator,
 	ICombatInterface* InstigatorCI,
-	const TSharedPtr<FAttackInfo>& AttackInfoPtr,
+	const FAttackInfo& AttackInfo,
 	const bool bCritHit,
 	const bool bAttackBlocked)
 {
-	float ActualDamage = 0.f;
-
 	UStatsComponentBase* StatsComp = GetStatsComponent();
-	if (!StatsComp || !AttackInfoPtr.IsValid())
-	{
-		return ActualDamage;
-	}
-
-	if (bCritHit)
-	{
-		ActualDamage = AttackInfoPtr->CritDamage;
-	}
-	else
+	if (!StatsComp)
 	{
-		ActualDamage = AttackInfoPtr->NormalDamage;
-	}
-
-	if (bAttackBlocked)
-	{
-		float DamageReductionOnBlock = 0.1f;
-		if (StatsComp)
-		{
-			if (AttackInfoPtr->DamageType == EDamageType::Magickal)
-			{
-				DamageReductionOnBlock = StatsComp->MagickalDamageReductionOnBlock.GetValue();
-			}
-			else
-			{
-				DamageReductionOnBlock = StatsComp->PhysicalDamageReductionOnBlock.GetValue();
-			}
-		}
-		DamageReductionOnBlock = DamageReductionOnBlock > 100.f ? 100.f : DamageReductionOnBlock;
-		ActualDamage = ActualDamage * (1 - DamageReductionOnBlock / 100.f);
+		return 0.f;
 	}
 
-	return ActualDamage;
+	const FDamageDefense Defense = FDamageCalculator::GetDefense(StatsComp, AttackInfo.DamageType);
+	return FDamageCalculator::CalculateDamage(AttackInfo, Defense, bCritHit).GetDamage(bAttackBlocked);
 }
 
 void AEODCharacterBase::TriggerReceivedHitCosmetics(const FReceivedHitInfo& HitInfo)
@@ -827,18 +880,18 @@ bool AEODCharacterBase::ApplyCCE(
 	bool bAttackBlocked)
 {
 	bool bCCEApplied = false;
-	if (!bAttackBlocked)
+	if (CanReceiveCCE(CCEToApply, bAttackBlocked))
 	{
 		switch (CCEToApply)
 		{
 		case ECrowdControlEffect::Flinch:
-			bCCEApplied = CCEFlinch(BCAngle);
+			bCCEApplied = ApplyFlinch(BCAngle);
 			break;
 		case ECrowdControlEffect::Interrupt:
-			bCCEApplied = CCEInterrupt(BCAngle);
+			bCCEApplied = ApplyInterrupt(BCAngle);
 			break;
 		case ECrowdControlEffect::KnockedDown:
-			bCCEApplied = CCEKnockdown(CCEDuration);
+			bCCEApplied = ApplyKnockdown(CCEDuration);
 			// If the character has a controller it means either character is locally controlled or on server, 
 			// so we don't need check for ENetRole
 			//~ @note:	Previously I was rotating the character only on server, which resulted in character rotating
@@ -860,7 +913,7 @@ bool AEODCharacterBase::ApplyCCE(
 			}
 			break;
 		case ECrowdControlEffect::KnockedBack:
-			bCCEApplied = CCEKnockback(CCEDuration, HitInstigator->GetActorForwardVector());
+			bCCEApplied = ApplyKnockback(CCEDuration, HitInstigator->GetActorForwardVector());
 			if (bCCEApplied && Controller)
 			{
 				FVector OrientationVector = HitInstigator->GetActorLocation() - GetActorLocation();
@@ -878,10 +931,10 @@ bool AEODCharacterBase::ApplyCCE(
 			}
 			break;
 		case ECrowdControlEffect::Stunned:
-			bCCEApplied = CCEStun(CCEDuration);
+			bCCEApplied = ApplyStun(CCEDuration);
 			break;
 		case ECrowdControlEffect::Crystalized:
-			bCCEApplied = CCEFreeze(CCEDuration);
+			bCCEApplied = ApplyFreeze(CCEDuration);
 			break;
 		default:
 			break;
@@ -890,11 +943,29 @@ bool AEODCharacterBase::ApplyCCE(
 	return bCCEApplied;
 }
 
-TSharedPtr<FAttackInfo> AEODCharacterBase::GetAttackInfoPtrFromNormalAttack(const FString& NormalAttackStr)
+bool AEODCharacterBase::GetAttackInfoFromNormalAttack(const FName& NormalAttackName, FAttackInfo& OutAttackInfo)
+{
+	const FAttackInfo* CachedAttackInfo = NormalAttackInfoCache.Find(NormalAttackName);
+	if (CachedAttackInfo)
+	{
+		OutAttackInfo = *CachedAttackInfo;
+		return true;
+	}
+
+	if (CalculateNormalAttackInfo(NormalAttackName.ToString(), OutAttackInfo))
+	{
+		NormalAttackInfoCache.Add(NormalAttackName, OutAttackInfo);
+		return true;
+	}
+
+	return false;
+}
+
+bool AEODCharacterBase::CalculateNormalAttackInfo(const FString& NormalAttackStr, FAttackInfo& OutAttackInfo)
 {
 	if (Role < ROLE_Authority)
 	{
-		return TSharedPtr<FAttackInfo>();
+		return false;
 	}
 
 	int32 NormalAttackIndex = GetAttackIndexFromNormalAttackString(NormalAttackStr);
@@ -948,20 +1019,90 @@ TSharedPtr<FAttackInfo> AEODCharacterBase::GetAttackInfoPtrFromNormalAttack(cons
 		(NormalDamage * UCombatLibrary::MagickalCritMultiplier + StatsComp->MagickalCritBonus.GetValue()) :
 		(NormalDamage * UCombatLibrary::PhysicalCritMultiplier + StatsComp->PhysicalCritBonus.GetValue());
 
-	TSharedPtr<FAttackInfo> AttackInfoPtr =
-		MakeShareable(new FAttackInfo(
-			false,
-			false,
-			CritRate,
-			NormalDamage,
-			CritDamage,
-			DamageType,
-			ECrowdControlEffect::Flinch,
-			0.f,
-			ECameraShakeType::Weak
-		));
+	OutAttackInfo = FAttackInfo(
+		false,
+		false,
+		CritRate,
+		NormalDamage,
+		CritDamage,
+		DamageType,
+		ECrowdControlEffect::Flinch,
+		0.f,
+		ECameraShakeType::Weak);
 
-	return AttackInfoPtr;
+	return true;
+}
+
+FMaskFilter AEODCharacterBase::GetCombatIgnoreMask() const
+{
+	// Player characters can attack anyone
+	return 0;
+}
+
+void AEODCharacterBase::UpdateFactionMaskFilter()
+{
+	const FMaskFilter MaskFilter = UCharacterLibrary::GetFactionMaskFilter(Faction);
+
+	UCapsuleComponent* CapsuleComp = GetCapsuleComponent();
+	if (CapsuleComp)
+	{
+		CapsuleComp->SetMaskFilterOnBodyInstance(MaskFilter);
+	}
+
+	USkeletalMeshComponent* MeshComp = GetMesh();
+	if (MeshComp)
+	{
+		MeshComp->SetMaskFilterOnBodyInstance(MaskFilter);
+		// Physics asset bodies have already been created by now
+		for (FBodyInstance* Body : MeshComp->Bodies)
+		{
+			if (Body)
+			{
+				Body->SetMaskFilter(MaskFilter);
+			}
+		}
+	}
+}
+
+void AEODCharacterBase::InvalidateNormalAttackInfoCache()
+{
+	// Keep the allocation, the cache will be refilled with the same number of normal attacks
+	NormalAttackInfoCache.Reset();
+}
+
+void AEODCharacterBase::BindNormalAttackStatDelegates(UStatsComponentBase* StatsComp)
+{
+	if (!StatsComp || Role < ROLE_Authority)
+	{
+		return;
+	}
+
+	StatsComp->PhysicalAttack.OnStatValueChanged.AddUObject(this, &AEODCharacterBase::OnNormalAttackStatChanged);
+	StatsComp->MagickalAttack.OnStatValueChanged.AddUObject(this, &AEODCharacterBase::OnNormalAttackStatChanged);
+	StatsComp->PhysicalCritRate.OnStatValueChanged.AddUObject(this, &AEODCharacterBase::OnNormalAttackStatChanged);
+	StatsComp->MagickalCritRate.OnStatValueChanged.AddUObject(this, &AEODCharacterBase::OnNormalAttackStatChanged);
+	StatsComp->PhysicalCritBonus.OnStatValueChanged.AddUObject(this, &AEODCharacterBase::OnNormalAttackStatChanged);
+	StatsComp->MagickalCritBonus.OnStatValueChanged.AddUObject(this, &AEODCharacterBase::OnNormalAttackStatChanged);
+}
+
+void AEODCharacterBase::UnbindNormalAttackStatDelegates(UStatsComponentBase* StatsComp)
+{
+	if (!StatsComp)
+	{
+		return;
+	}
+
+	StatsComp->PhysicalAttack.OnStatValueChanged.RemoveAll(this);
+	StatsComp->MagickalAttack.OnStatValueChanged.RemoveAll(this);
+	StatsComp->PhysicalCritRate.OnStatValueChanged.RemoveAll(this);
+	StatsComp->MagickalCritRate.OnStatValueChanged.RemoveAll(this);
+	StatsComp->PhysicalCritBonus.OnStatValueChanged.RemoveAll(this);
+	StatsComp->MagickalCritBonus.OnStatValueChanged.RemoveAll(this);
+}
+
+void AEODCharacterBase::OnNormalAttackStatChanged(float NewValue)
+{
+	InvalidateNormalAttackInfoCache();
 }
 
 EWeaponType AEODCharacterBase::GetWeaponTypeFromNormalAttackString(const FString& NormalAttackStr)
@@ -1912,93 +2053,3 @@ bool AEODCharacterBase::Server_SetBlockMovementDirectionYaw_Validate(float NewYa
 {
 	return true;
 }
-
-bool AEODCharacterBase::CanFlinch() const
-{
-	if (CharacterStateInfo.CharacterState == ECharacterState::Dead)
-	{
-		return false;
-	}
-
-	UStatsComponentBase* StatsComp = GetStatsComponent();
-	if (StatsComp)
-	{
-		return !StatsComp->CCImmunities.HasCCImmunity(ECrowdControlEffect::Flinch);
-	}
-	return true;
-}
-
-bool AEODCharacterBase::CanStun() const
-{
-	if (CharacterStateInfo.CharacterState == ECharacterState::Dead)
-	{
-		return false;
-	}
-
-	UStatsComponentBase* StatsComp = GetStatsComponent();
-	if (StatsComp)
-	{
-		return !StatsComp->CCImmunities.HasCCImmunity(ECrowdControlEffect::Stunned);
-	}
-	return true;
-}
-
-bool AEODCharacterBase::CanKnockdown() const
-{
-	if (CharacterStateInfo.CharacterState == ECharacterState::Dead)
-	{
-		return false;
-	}
-
-	UStatsComponentBase* StatsComp = GetStatsComponent();
-	if (StatsComp)
-	{
-		return !StatsComp->CCImmunities.HasCCImmunity(ECrowdControlEffect::KnockedDown);
-	}
-	return true;
-}
-
-bool AEODCharacterBase::CanKnockback() const
-{
-	if (CharacterStateInfo.CharacterState == ECharacterState::Dead)
-	{
-		return false;
-	}
-
-	UStatsComponentBase* StatsComp = GetStatsComponent();
-	if (StatsComp)
-	{
-		return !StatsComp->CCImmunities.HasCCImmunity(ECrowdControlEffect::KnockedBack);
-	}
-	return true;
-}
-
-bool AEODCharacterBase::CanFreeze() const
-{
-	if (CharacterStateInfo.CharacterState == ECharacterState::Dead)
-	{
-		return false;
-	}
-
-	UStatsComponentBase* StatsComp = GetStatsComponent();
-	if (StatsComp)
-	{
-		return !StatsComp->CCImmunities.HasCCImmunity(ECrowdControlEffect::Crystalized);
-	}
-	return true;
-}
-
-bool AEODCharacterBase::CanInterrupt() const
-{
-	if (CharacterStateInfo.CharacterState == ECharacterState::Dead)
-	{
-		return false;
-	}
-
-	UStatsComponentBase* StatsComp = GetStatsComponent();
-	if (StatsComp)
-	{
-		return !StatsComp->CCImmunities.HasCCImmunity(ECrowdControlEffect::Interrupt);
-	}
-	return true;
-}
@@ -300,6 +300,7 @@ void AHumanCharacter::SetCurrentPrimaryWeapon(const FName WeaponID)
 	}
 	PrimaryWeapon->OnEquip(WeaponID, WeaponData);
 	EquippedWeapons.SetPrimaryWeaponID(WeaponID);
+	InvalidateNormalAttackInfoCache();
 
 	LoadAnimationReferencesForWeapon(WeaponData->WeaponType);
 	// UpdateCurrentWeaponAnimationType();
@@ -340,6 +341,7 @@ void AHumanCharacter::RemovePrimaryWeapon()
 {
 	// OnPrimaryWeaponUnequipped.Broadcast(PrimaryWeaponID, PrimaryWeaponDataAsset);
 	EquippedWeapons.SetPrimaryWeaponID(NAME_None);
+	InvalidateNormalAttackInfoCache();
 	// PrimaryWeaponDataAsset = nullptr;
 
 	/*
@@ -819,103 +821,94 @@ void AHumanCharacter::SetNormalAttackSectionChangeAllowed(bool bNewValue)
 	bNormalAttackSectionChangeAllowed = bNewValue;
 }
 
-bool AHumanCharacter::CCEFlinch(const float BCAngle)
+bool AHumanCharacter::ApplyFlinch(const float BCAngle)
 {
-	if (CanFlinch())
+	FPlayerAnimationReferencesTableRow* Anims = GetActiveAnimationReferences();
+	UAnimMontage* FlinchMontage = Anims ? Anims->Flinch.Get() : nullptr;
+	if (FlinchMontage)
 	{
-		FPlayerAnimationReferencesTableRow* Anims = GetActiveAnimationReferences();
-		UAnimMontage* FlinchMontage = Anims ? Anims->Flinch.Get() : nullptr;
-		if (FlinchMontage)
+		if (BCAngle <= 90)
 		{
-			if (BCAngle <= 90)
-			{
-				PlayAnimMontage(FlinchMontage, 1.f, UCharacterLibrary::SectionName_ForwardFlinch);
-			}
-			else
-			{
-				PlayAnimMontage(FlinchMontage, 1.f, UCharacterLibrary::SectionName_BackwardFlinch);
-			}
-			return true;
+			PlayAnimMontage(FlinchMontage, 1.f, UCharacterLibrary::SectionName_ForwardFlinch);
 		}
+		else
+		{
+			PlayAnimMontage(FlinchMontage, 1.f, UCharacterLibrary::SectionName_BackwardFlinch);
+		}
+		return true;
 	}
 	return false;
 }
 
-bool AHumanCharacter::CCEInterrupt(const float BCAngle)
+bool AHumanCharacter::ApplyInterrupt(const float BCAngle)
 {
-	if (CanInterrupt())
+	FPlayerAnimationReferencesTableRow* AnimRef = GetActiveAnimationReferences();
+	UAnimMontage* AnimMontage = AnimRef ? AnimRef->Interrupt.Get() : nullptr;
+	if (AnimMontage)
 	{
-		FPlayerAnimationReferencesTableRow* AnimRef = GetActiveAnimationReferences();
-		UAnimMontage* AnimMontage = AnimRef ? AnimRef->Interrupt.Get() : nullptr;
-		if (AnimMontage)
-		{
-			PreCCEStateEnter();
-
-			float InterruptDuration = 0.f;
-			int32 NumOfSections = 2; // Forward interrupt and backward interrupt
-			if (BCAngle <= 90)
-			{
-				InterruptDuration = (PlayAnimMontage(AnimMontage, 1.f, UCharacterLibrary::SectionName_ForwardInterrupt)) / NumOfSections;
-			}
-			else
-			{
-				InterruptDuration = (PlayAnimMontage(AnimMontage, 1.f, UCharacterLibrary::SectionName_BackwardInterrupt)) / NumOfSections;
-			}
+		PreCCEStateEnter();
 
-			CharacterStateInfo.CharacterState = ECharacterState::GotHit;
-			bCharacterStateAllowsMovement = false;
-			bCharacterStateAllowsRotation = false;
-			UEODCharacterMovementComponent* MoveComp = Cast<UEODCharacterMovementComponent>(GetCharacterMovement());
-			if (MoveComp)
-			{
-				MoveComp->bUseControllerDesiredRotation = false;
-			}
+		float InterruptDuration = 0.f;
+		int32 NumOfSections = 2; // Forward interrupt and backward interrupt
+		if (BCAngle <= 90)
+		{
+			InterruptDuration = (PlayAnimMontage(AnimMontage, 1.f, UCharacterLibrary::SectionName_ForwardInterrupt)) / NumOfSections;
+		}
+		else
+		{
+			InterruptDuration = (PlayAnimMontage(AnimMontage, 1.f, UCharacterLibrary::SectionName_BackwardInterrupt)) / NumOfSections;
+		}
 
-			InterruptDuration = InterruptDuration - AnimMontage->BlendOut.GetBlendTime();
-			if (InterruptDuration > 0.f)
-			{
-				UWorld* World = GetWorld();
-				check(World);
-				World->GetTimerManager().SetTimer(CrowdControlTimerHandle, this, &AHumanCharacter::ResetState, InterruptDuration);
-			}
-			else
-			{
-				ResetState();
-			}
+		CharacterStateInfo.CharacterState = ECharacterState::GotHit;
+		bCharacterStateAllowsMovement = false;
+		bCharacterStateAllowsRotation = false;
+		UEODCharacterMovementComponent* MoveComp = Cast<UEODCharacterMovementComponent>(GetCharacterMovement());
+		if (MoveComp)
+		{
+			MoveComp->bUseControllerDesiredRotation = false;
+		}
 
-			return true;
+		InterruptDuration = InterruptDuration - AnimMontage->BlendOut.GetBlendTime();
+		if (InterruptDuration > 0.f)
+		{
+			UWorld* World = GetWorld();
+			check(World);
+			World->GetTimerManager().SetTimer(CrowdControlTimerHandle, this, &AHumanCharacter::ResetState, InterruptDuration);
+		}
+		else
+		{
+			ResetState();
 		}
+
+		return true;
 	}
 	return false;
 }
 
-bool AHumanCharacter::CCEStun(const float Duration)
+bool AHumanCharacter::ApplyStun(const float Duration)
 {
-	if (CanStun())
+	FPlayerAnimationReferencesTableRow* AnimRef = GetActiveAnimationReferences();
+	UAnimMontage* AnimMontage = AnimRef ? AnimRef->Stun.Get() : nullptr;
+	if (AnimMontage)
 	{
-		FPlayerAnimationReferencesTableRow* AnimRef = GetActiveAnimationReferences();
-		UAnimMontage* AnimMontage = AnimRef ? AnimRef->Stun.Get() : nullptr;
-		if (AnimMontage)
-		{
-			PreCCEStateEnter();
+		PreCCEStateEnter();
 
-			PlayAnimMontage(AnimMontage, 1.f);
+		PlayAnimMontage(AnimMontage, 1.f);
 
-			UWorld* World = GetWorld();
-			check(World);
-			World->GetTimerManager().SetTimer(CrowdControlTimerHandle, this, &AHumanCharacter::CCERemoveStun, Duration, false);
-
-			CharacterStateInfo.CharacterState = ECharacterState::GotHit;
-			bCharacterStateAllowsMovement = false;
-			bCharacterStateAllowsRotation = false;
-			UEODCharacterMovementComponent* MoveComp = Cast<UEODCharacterMovementComponent>(GetCharacterMovement());
-			if (MoveComp)
-			{
-				MoveComp->bUseControllerDesiredRotation = false;
-			}
+		UWorld* World = GetWorld();
+		check(World);
+		World->GetTimerManager().SetTimer(CrowdControlTimerHandle, this, &AHumanCharacter::CCERemoveStun, Duration, false);
 
-			return true;
+		CharacterStateInfo.CharacterState = ECharacterState::GotHit;
+		bCharacterStateAllowsMovement = false;
+		bCharacterStateAllowsRotation = false;
+		UEODCharacterMovementComponent* MoveComp = Cast<UEODCharacterMovementComponent>(GetCharacterMovement());
+		if (MoveComp)
+		{
+			MoveComp->bUseControllerDesiredRotation = false;
 		}
+
+		return true;
 	}
 	return false;
 }
@@ -937,9 +930,9 @@ void AHumanCharacter::CCERemoveStun()
 	World->GetTimerManager().ClearTimer(CrowdControlTimerHandle);
 }
 
-bool AHumanCharacter::CCEFreeze(const float Duration)
+bool AHumanCharacter::ApplyFreeze(const float Duration)
 {
-	if (CanFreeze() && GetMesh())
+	if (GetMesh())
 	{
 		PreCCEStateEnter();
 
@@ -977,33 +970,30 @@ void AHumanCharacter::CCEUnfreeze()
 	World->GetTimerManager().ClearTimer(CrowdControlTimerHandle);
 }
 
-bool AHumanCharacter::CCEKnockdown(const float Duration)
+bool AHumanCharacter::ApplyKnockdown(const float Duration)
 {
-	if (CanKnockdown())
+	FPlayerAnimationReferencesTableRow* AnimRef = GetActiveAnimationReferences();
+	UAnimMontage* KnockdownMontage = AnimRef ? AnimRef->Knockdown.Get() : nullptr;
+	if (KnockdownMontage)
 	{
-		FPlayerAnimationReferencesTableRow* AnimRef = GetActiveAnimationReferences();
-		UAnimMontage* KnockdownMontage = AnimRef ? AnimRef->Knockdown.Get() : nullptr;
-		if (KnockdownMontage)
-		{
-			PreCCEStateEnter();
-
-			PlayAnimMontage(KnockdownMontage, 1.f, UCharacterLibrary::SectionName_KnockdownStart);
+		PreCCEStateEnter();
 
-			UWorld* World = GetWorld();
-			check(World);
-			World->GetTimerManager().SetTimer(CrowdControlTimerHandle, this, &AHumanCharacter::CCEEndKnockdown, Duration, false);
+		PlayAnimMontage(KnockdownMontage, 1.f, UCharacterLibrary::SectionName_KnockdownStart);
 
-			CharacterStateInfo.CharacterState = ECharacterState::GotHit;
-			bCharacterStateAllowsMovement = false;
-			bCharacterStateAllowsRotation = false;
-			UEODCharacterMovementComponent* MoveComp = Cast<UEODCharacterMovementComponent>(GetCharacterMovement());
-			if (MoveComp)
-			{
-				MoveComp->bUseControllerDesiredRotation = false;
-			}
+		UWorld* World = GetWorld();
+		check(World);
+		World->GetTimerManager().SetTimer(CrowdControlTimerHandle, this, &AHumanCharacter::CCEEndKnockdown, Duration, false);
 
-			return true;
+		CharacterStateInfo.CharacterState = ECharacterState::GotHit;
+		bCharacterStateAllowsMovement = false;
+		bCharacterStateAllowsRotation = false;
+		UEODCharacterMovementComponent* MoveComp = Cast<UEODCharacterMovementComponent>(GetCharacterMovement());
+		if (MoveComp)
+		{
+			MoveComp->bUseControllerDesiredRotation = false;
 		}
+
+		return true;
 	}
 	return false;
 }
@@ -1031,9 +1021,9 @@ void AHumanCharacter::CCEEndKnockdown()
 	}
 }
 
-bool AHumanCharacter::CCEKnockback(const float Duration, const FVector& ImpulseDirection)
+bool AHumanCharacter::ApplyKnockback(const float Duration, const FVector& ImpulseDirection)
 {
-	bool bKnockdownInitiated = CCEKnockdown(Duration);
+	bool bKnockdownInitiated = ApplyKnockdown(Duration);
 	if (bKnockdownInitiated)
 	{
 		PushBack(ImpulseDirection);
@@ -261,23 +261,30 @@ void APlayerCharacter::LoadCharacterState()
 	}
 }
 
-TSharedPtr<FAttackInfo> APlayerCharacter::GetAttackInfoPtr(const FName& SkillGroup, const int32 CollisionIndex)
+bool APlayerCharacter::GetAttackInfo(const FName& SkillGroup, const int32 CollisionIndex, FAttackInfo& OutAttackInfo)
 {
+	// Normal attacks are the most frequent attacks, so check the cache before doing any string work
+	const FAttackInfo* CachedAttackInfo = NormalAttackInfoCache.Find(SkillGroup);
+	if (CachedAttackInfo)
+	{
+		OutAttackInfo = *CachedAttackInfo;
+		return true;
+	}
+
 	const FString& SkillGroupStr = SkillGroup.ToString();
 	if (SkillGroupStr.Contains("-normal-"))
 	{
-		return GetAttackInfoPtrFromNormalAttack(SkillGroupStr);
+		return GetAttackInfoFromNormalAttack(SkillGroup, OutAttackInfo);
 	}
 	else
 	{
 		UGameplaySkillsComponent* SkillComp = GetGameplaySkillsComponent();
 		UGameplaySkillBase* Skill = SkillComp ? SkillComp->GetSkillForSkillGroup(SkillGroup) : nullptr;
-		TSharedPtr<FAttackInfo> AttackInfoPtr = Skill ? Skill->GetAttackInfoPtr(CollisionIndex) : TSharedPtr<FAttackInfo>();
-		return AttackInfoPtr;
+		return Skill ? Skill->GetAttackInfo(CollisionIndex, OutAttackInfo) : false;
 	}
 }
 
-void APlayerCharacter::PostAttack(const TArray<FAttackResponse>& AttackResponses, const TArray<AActor*> HitActors)
+void APlayerCharacter::PostAttack(const TArray<FAttackResponse>& AttackResponses, const TArray<AActor*>& HitActors)
 {
 	LastAttackResponses = AttackResponses;
 	if (AttackResponses.Num() == 0)
@@ -7,9 +7,9 @@ UCombatInterface::UCombatInterface(const FObjectInitializer& ObjectInitializer)
 	
 }
 
-TSharedPtr<FAttackInfo> ICombatInterface::GetAttackInfoPtr(const FName& SkillGroup, const int32 CollisionIndex)
+bool ICombatInterface::GetAttackInfo(const FName& SkillGroup, const int32 CollisionIndex, FAttackInfo& OutAttackInfo)
 {
-	return TSharedPtr<FAttackInfo>();
+	return false;
 }
 
 AActor* ICombatInterface::GetInterfaceOwner()
@@ -22,25 +22,27 @@ bool ICombatInterface::IsEnemyOf(ICombatInterface* TargetCI) const
 	return true;
 }
 
-void ICombatInterface::PostAttack(const TArray<FAttackResponse>& AttackResponses, const TArray<AActor*> HitActors)
+void ICombatInterface::PostAttack(const TArray<FAttackResponse>& AttackResponses, const TArray<AActor*>& HitActors)
 {
 }
 
-TSharedPtr<FAttackResponse> ICombatInterface::ReceiveAttack(
+bool ICombatInterface::ReceiveAttack(
 	AActor* HitInstigator,
 	ICombatInterface* InstigatorCI,
-	const TSharedPtr<FAttackInfo>& AttackInfoPtr,
+	const FAttackInfo& AttackInfo,
 	const FHitResult& DirectHitResult,
 	const bool bLineHitResultFound,
-	const FHitResult& LineHitResult)
+	const FHitResult& LineHitResult,
+	FAttackResponse& OutAttackResponse,
+	const FDamageOutcome* PrecomputedDamage)
 {
-	return TSharedPtr<FAttackResponse>(nullptr);
+	return false;
 }
 
 float ICombatInterface::GetActualDamage(
 	AActor* HitInstigator,
 	ICombatInterface* InstigatorCI,
-	const TSharedPtr<FAttackInfo>& AttackInfoPtr,
+	const FAttackInfo& AttackInfo,
 	const bool bCritHit,
 	const bool bAttackBlocked)
 {
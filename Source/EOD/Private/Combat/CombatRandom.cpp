@@ -0,0 +1,29 @@
+// Copyright 2018 Moikkai Games. All Rights Reserved.
+
+#include "CombatRandom.h"
+
+FCombatRandom::FCombatRandom() :
+	EncounterSeed(0),
+	NextAttackIndex(0),
+	DecisionStream(0)
+{
+}
+
+void FCombatRandom::Initialize(int32 InEncounterSeed)
+{
+	EncounterSeed = InEncounterSeed;
+	NextAttackIndex = 0;
+	// Keyed past any attack index an encounter can reach, so decisions never draw the same numbers as an attack
+	DecisionStream.Initialize((int32)HashCombine(GetTypeHash(EncounterSeed), MAX_uint32));
+}
+
+FRandomStream FCombatRandom::NextAttackStream()
+{
+	return GetAttackStream(EncounterSeed, NextAttackIndex++);
+}
+
+FRandomStream FCombatRandom::GetAttackStream(int32 EncounterSeed, uint32 AttackIndex)
+{
+	// Consecutive seeds give correlated first numbers from the underlying LCG, so the attack index is hashed rather than added to the seed
+	return FRandomStream((int32)HashCombine(GetTypeHash(EncounterSeed), GetTypeHash(AttackIndex)));
+}
@@ -0,0 +1,206 @@
+// Copyright 2018 Moikkai Games. All Rights Reserved.
+
+#include "CombatRecorder.h"
+
+#include "Misc/FileHelper.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+/** Identifies combat recording files */
+static const uint32 CombatRecordingMagic = 0x434F4445; // 'EODC'
+
+/** Must be bumped whenever the layout of a record changes, since records are stored as raw bytes */
+static const uint32 CombatRecordingVersion = 1;
+
+static_assert(TIsTriviallyDestructible<FCombatAttackRecord>::Value && TIsTriviallyDestructible<FCombatHitRequestRecord>::Value, "Combat records are stored as raw bytes");
+
+FAttackInfo FCombatAttackRecord::GetAttackInfo() const
+{
+	FAttackInfo AttackInfo;
+	AttackInfo.bUndodgable = bUndodgable;
+	AttackInfo.bUnblockable = bUnblockable;
+	AttackInfo.CritRate = CritRate;
+	AttackInfo.NormalDamage = NormalDamage;
+	AttackInfo.CritDamage = CritDamage;
+	AttackInfo.DamageType = DamageType;
+	AttackInfo.CrowdControlEffect = CrowdControlEffect;
+	AttackInfo.CrowdControlEffectDuration = CrowdControlEffectDuration;
+	return AttackInfo;
+}
+
+FCombatRecorder::FCombatRecorder() :
+	Tail(0),
+	NumUsedBytes(0),
+	NumDroppedEvents(0),
+	EncounterSeed(0),
+	bRecording(false)
+{
+}
+
+void FCombatRecorder::Start(int32 CapacityBytes, int32 InEncounterSeed)
+{
+	Buffer.SetNumUninitialized(FMath::Max(CapacityBytes, 0));
+	Tail = 0;
+	NumUsedBytes = 0;
+	NumDroppedEvents = 0;
+	EncounterSeed = InEncounterSeed;
+	bRecording = Buffer.Num() > 0;
+}
+
+void FCombatRecorder::Stop()
+{
+	bRecording = false;
+}
+
+void FCombatRecorder::RecordHitRequest(const FCombatHitRequestRecord& Record)
+{
+	Write(ECombatRecordType::HitRequest, &Record, sizeof(Record));
+}
+
+void FCombatRecorder::RecordAttack(const FCombatAttackRecord& Record)
+{
+	Write(ECombatRecordType::Attack, &Record, sizeof(Record));
+}
+
+int32 FCombatRecorder::GetRecordSize(ECombatRecordType Type)
+{
+	switch (Type)
+	{
+	case ECombatRecordType::HitRequest:
+		return sizeof(FCombatHitRequestRecord);
+	case ECombatRecordType::Attack:
+		return sizeof(FCombatAttackRecord);
+	default:
+		return INDEX_NONE;
+	}
+}
+
+void FCombatRecorder::Write(ECombatRecordType Type, const void* Record, int32 RecordSize)
+{
+	const int32 EventSize = RecordSize + 1;
+	if (!bRecording || EventSize > Buffer.Num())
+	{
+		return;
+	}
+
+	while (Buffer.Num() - NumUsedBytes < EventSize)
+	{
+		DropOldestEvent();
+	}
+
+	const int32 Head = (Tail + NumUsedBytes) % Buffer.Num();
+	const uint8 TypeByte = (uint8)Type;
+	WriteBytes(Head, &TypeByte, 1);
+	WriteBytes((Head + 1) % Buffer.Num(), Record, RecordSize);
+	NumUsedBytes += EventSize;
+}
+
+void FCombatRecorder::WriteBytes(int32 Offset, const void* Data, int32 Size)
+{
+	const int32 FirstPartSize = FMath::Min(Size, Buffer.Num() - Offset);
+	FMemory::Memcpy(Buffer.GetData() + Offset, Data, FirstPartSize);
+	if (FirstPartSize < Size)
+	{
+		FMemory::Memcpy(Buffer.GetData(), (const uint8*)Data + FirstPartSize, Size - FirstPartSize);
+	}
+}
+
+void FCombatRecorder::ReadBytes(int32 Offset, void* Data, int32 Size) const
+{
+	const int32 FirstPartSize = FMath::Min(Size, Buffer.Num() - Offset);
+	FMemory::Memcpy(Data, Buffer.GetData() + Offset, FirstPartSize);
+	if (FirstPartSize < Size)
+	{
+		FMemory::Memcpy((uint8*)Data + FirstPartSize, Buffer.GetData(), Size - FirstPartSize);
+	}
+}
+
+void FCombatRecorder::DropOldestEvent()
+{
+	check(NumUsedBytes > 0);
+
+	uint8 TypeByte;
+	ReadBytes(Tail, &TypeByte, 1);
+	const int32 EventSize = GetRecordSize((ECombatRecordType)TypeByte) + 1;
+	check(EventSize > 1);
+
+	Tail = (Tail + EventSize) % Buffer.Num();
+	NumUsedBytes -= EventSize;
+	NumDroppedEvents++;
+}
+
+bool FCombatRecorder::SaveToFile(const FString& Filename) const
+{
+	TArray<uint8> FileData;
+	FMemoryWriter Writer(FileData);
+
+	uint32 Magic = CombatRecordingMagic;
+	uint32 Version = CombatRecordingVersion;
+	int32 Seed = EncounterSeed;
+	int32 NumBytes = NumUsedBytes;
+	Writer << Magic << Version << Seed << NumBytes;
+
+	// Events are written oldest first so the file never wraps
+	const int32 HeaderSize = FileData.Num();
+	FileData.AddUninitialized(NumUsedBytes);
+	if (NumUsedBytes > 0)
+	{
+		ReadBytes(Tail, FileData.GetData() + HeaderSize, NumUsedBytes);
+	}
+
+	return FFileHelper::SaveArrayToFile(FileData, *Filename);
+}
+
+bool FCombatRecorder::LoadFromFile(const FString& Filename, FCombatRecording& OutRecording)
+{
+	TArray<uint8> FileData;
+	if (!FFileHelper::LoadFileToArray(FileData, *Filename))
+	{
+		return false;
+	}
+
+	FMemoryReader Reader(FileData);
+	uint32 Magic = 0;
+	uint32 Version = 0;
+	int32 NumBytes = 0;
+	Reader << Magic << Version << OutRecording.EncounterSeed << NumBytes;
+	if (Reader.IsError() || Magic != CombatRecordingMagic || Version != CombatRecordingVersion)
+	{
+		return false;
+	}
+
+	const int32 HeaderSize = (int32)Reader.Tell();
+	if (NumBytes < 0 || HeaderSize + NumBytes > FileData.Num())
+	{
+		return false;
+	}
+
+	OutRecording.HitRequests.Reset();
+	OutRecording.Attacks.Reset();
+
+	const uint8* Data = FileData.GetData() + HeaderSize;
+	int32 Offset = 0;
+	while (Offset < NumBytes)
+	{
+		const ECombatRecordType Type = (ECombatRecordType)Data[Offset];
+		const int32 RecordSize = GetRecordSize(Type);
+		if (RecordSize == INDEX_NONE || Offset + 1 + RecordSize > NumBytes)
+		{
+			return false;
+		}
+
+		const uint8* RecordData = Data + Offset + 1;
+		if (Type == ECombatRecordType::HitRequest)
+		{
+			FMemory::Memcpy(&OutRecording.HitRequests[OutRecording.HitRequests.AddUninitialized()], RecordData, RecordSize);
+		}
+		else
+		{
+			FMemory::Memcpy(&OutRecording.Attacks[OutRecording.Attacks.AddUninitialized()], RecordData, RecordSize);
+		}
+
+		Offset += 1 + RecordSize;
+	}
+
+	return true;
+}
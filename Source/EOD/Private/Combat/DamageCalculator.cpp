@@ -0,0 +1,142 @@
+// Copyright 2018 Moikkai Games. All Rights Reserved.
+
+#include "DamageCalculator.h"
+#include "EODCharacterBase.h"
+#include "StatsComponentBase.h"
+
+DECLARE_CYCLE_STAT(TEXT("EOD Damage Batch"), STAT_EODDamageBatch, STATGROUP_EOD);
+
+FDamageDefense FDamageCalculator::GetDefense(const UStatsComponentBase* StatsComp, EDamageType DamageType)
+{
+	FDamageDefense Defense;
+	if (StatsComp)
+	{
+		const bool bMagickal = DamageType == EDamageType::Magickal;
+		Defense.Resistance = bMagickal ? StatsComp->MagickalResistance.GetValue() : StatsComp->PhysicalResistance.GetValue();
+		Defense.BlockReduction = bMagickal ? StatsComp->MagickalDamageReductionOnBlock.GetValue() : StatsComp->PhysicalDamageReductionOnBlock.GetValue();
+	}
+	//~ @todo elemental multiplier once attacks and characters have elements
+	return Defense;
+}
+
+FDamageDefense FDamageCalculator::GetDefense(const FStatsSnapshot& StatsSnapshot, EDamageType DamageType)
+{
+	FDamageDefense Defense;
+	const bool bMagickal = DamageType == EDamageType::Magickal;
+	Defense.Resistance = StatsSnapshot.GetValue(bMagickal ? EStatId::MagickalResistance : EStatId::PhysicalResistance);
+	Defense.BlockReduction = StatsSnapshot.GetValue(bMagickal ? EStatId::MagickalDamageReductionOnBlock : EStatId::PhysicalDamageReductionOnBlock);
+	return Defense;
+}
+
+FDamageOutcome FDamageCalculator::CalculateDamage(const FAttackInfo& AttackInfo, const FDamageDefense& Defense, bool bCritHit)
+{
+	// Keep the order of operations in sync with FDamageBatch::Calculate so both give bit identical results
+	const float DefenseFactor = GetResistanceFactor(Defense.Resistance) * Defense.ElementalMultiplier;
+	const float BaseDamage = bCritHit ? AttackInfo.CritDamage : AttackInfo.NormalDamage;
+
+	FDamageOutcome Outcome;
+	Outcome.bCritHit = bCritHit;
+	Outcome.Damage = FMath::Max(BaseDamage * DefenseFactor, 0.f);
+	Outcome.BlockedDamage = Outcome.Damage * GetBlockFactor(Defense.BlockReduction);
+	return Outcome;
+}
+
+float FDamageCalculator::GetResistanceFactor(float Resistance)
+{
+	return UCombatLibrary::CalculateDamage(1.f, Resistance);
+}
+
+float FDamageCalculator::GetBlockFactor(float BlockReduction)
+{
+	return 1.f - FMath::Clamp(BlockReduction, 0.f, 100.f) / 100.f;
+}
+
+FDamageBatch::FDamageBatch() :
+	NumAttacks(0)
+{
+}
+
+void FDamageBatch::Reset()
+{
+	NumAttacks = 0;
+	NormalDamage.Reset();
+	CritDamage.Reset();
+	CritRate.Reset();
+	DefenseFactor.Reset();
+	BlockFactor.Reset();
+	CritRolls.Reset();
+	Damage.Reset();
+	BlockedDamage.Reset();
+	CritMasks.Reset();
+}
+
+int32 FDamageBatch::AddAttack(const FAttackInfo& AttackInfo, const FDamageDefense& Defense, float CritRoll)
+{
+	const int32 Index = NumAttacks++;
+
+	// Grow the lanes a whole vector at a time, so the padding of the last vector is always zeroed
+	if (Index == NormalDamage.Num())
+	{
+		const int32 NumPadded = Index + LaneWidth;
+		NormalDamage.SetNumZeroed(NumPadded, false);
+		CritDamage.SetNumZeroed(NumPadded, false);
+		CritRate.SetNumZeroed(NumPadded, false);
+		DefenseFactor.SetNumZeroed(NumPadded, false);
+		BlockFactor.SetNumZeroed(NumPadded, false);
+		CritRolls.SetNumZeroed(NumPadded, false);
+		Damage.SetNumZeroed(NumPadded, false);
+		BlockedDamage.SetNumZeroed(NumPadded, false);
+		CritMasks.AddZeroed();
+	}
+
+	NormalDamage[Index] = AttackInfo.NormalDamage;
+	CritDamage[Index] = AttackInfo.CritDamage;
+	CritRate[Index] = AttackInfo.CritRate;
+	DefenseFactor[Index] = FDamageCalculator::GetResistanceFactor(Defense.Resistance) * Defense.ElementalMultiplier;
+	BlockFactor[Index] = FDamageCalculator::GetBlockFactor(Defense.BlockReduction);
+	CritRolls[Index] = CritRoll;
+
+	return Index;
+}
+
+void FDamageBatch::Calculate()
+{
+	SCOPE_CYCLE_COUNTER(STAT_EODDamageBatch);
+
+	const int32 NumPadded = NormalDamage.Num();
+	const VectorRegister Zero = VectorZero();
+	for (int32 Index = 0; Index < NumPadded; Index += LaneWidth)
+	{
+		const VectorRegister CritMask = VectorCompareGE(VectorLoadAligned(&CritRate[Index]), VectorLoadAligned(&CritRolls[Index]));
+		const VectorRegister BaseDamage = VectorSelect(CritMask, VectorLoadAligned(&CritDamage[Index]), VectorLoadAligned(&NormalDamage[Index]));
+		const VectorRegister FinalDamage = VectorMax(VectorMultiply(BaseDamage, VectorLoadAligned(&DefenseFactor[Index])), Zero);
+
+		VectorStoreAligned(FinalDamage, &Damage[Index]);
+		VectorStoreAligned(VectorMultiply(FinalDamage, VectorLoadAligned(&BlockFactor[Index])), &BlockedDamage[Index]);
+		CritMasks[Index / LaneWidth] = (uint8)VectorMaskBits(CritMask);
+	}
+}
+
+FDamageOutcome FDamageBatch::GetOutcome(int32 Index) const
+{
+	check(Index >= 0 && Index < NumAttacks);
+
+	FDamageOutcome Outcome;
+	Outcome.bCritHit = (CritMasks[Index / LaneWidth] & (1 << (Index % LaneWidth))) != 0;
+	Outcome.Damage = Damage[Index];
+	Outcome.BlockedDamage = BlockedDamage[Index];
+	return Outcome;
+}
+
+uint32 FDamageBatch::GetAllocatedSize() const
+{
+	return NormalDamage.GetAllocatedSize() +
+		CritDamage.GetAllocatedSize() +
+		CritRate.GetAllocatedSize() +
+		DefenseFactor.GetAllocatedSize() +
+		BlockFactor.GetAllocatedSize() +
+		CritRolls.GetAllocatedSize() +
+		Damage.GetAllocatedSize() +
+		BlockedDamage.GetAllocatedSize() +
+		CritMasks.GetAllocatedSize();
+}
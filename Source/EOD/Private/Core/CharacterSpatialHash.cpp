@@ -0,0 +1,325 @@
+// Copyright 2018 Moikkai Games. All Rights Reserved.
+
+#include "CharacterSpatialHash.h"
+#include "EODCharacterBase.h"
+
+#include "Components/CapsuleComponent.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "GameFramework/CharacterMovementComponent.h"
+
+DECLARE_CYCLE_STAT(TEXT("EOD CharacterSpatialHashUpdate"), STAT_EODCharacterSpatialHashUpdate, STATGROUP_EOD);
+
+FCharacterSpatialHash::FCharacterSpatialHash() :
+	CellSize(1000.f),
+	MaxEntryExtent(0.f),
+	LastUpdateFrame(MAX_uint64)
+{
+}
+
+void FCharacterSpatialHash::AddCharacter(AEODCharacterBase* Character)
+{
+	if (Character)
+	{
+		Characters.AddUnique(Character);
+		// Force a rebuild so the new character can be found by queries in this frame
+		LastUpdateFrame = MAX_uint64;
+	}
+}
+
+void FCharacterSpatialHash::RemoveCharacter(AEODCharacterBase* Character)
+{
+	Characters.RemoveSwap(Character);
+	LastUpdateFrame = MAX_uint64;
+}
+
+void FCharacterSpatialHash::UpdateForFrame(uint64 FrameNumber, float DeltaSeconds)
+{
+	if (LastUpdateFrame == FrameNumber)
+	{
+		return;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_EODCharacterSpatialHashUpdate);
+
+	LastUpdateFrame = FrameNumber;
+	Entries.Reset();
+	CellRanges.Reset();
+	MaxEntryExtent = 0.f;
+
+	for (int32 Index = Characters.Num() - 1; Index >= 0; Index--)
+	{
+		AEODCharacterBase* Character = Characters[Index].Get();
+		if (!IsValid(Character))
+		{
+			Characters.RemoveAtSwap(Index);
+			continue;
+		}
+
+		float Radius = 0.f;
+		float HalfHeight = 0.f;
+		UCapsuleComponent* CapsuleComp = Character->GetCapsuleComponent();
+		if (CapsuleComp)
+		{
+			CapsuleComp->GetScaledCapsuleSize(Radius, HalfHeight);
+		}
+
+		const FVector Location = Character->GetActorLocation();
+		const FVector Extent(Radius, Radius, HalfHeight);
+
+		FEntry Entry;
+		Entry.Character = Character;
+		Entry.Bounds = FBox(Location - Extent, Location + Extent);
+		Entry.Faction = Character->GetFaction();
+		Entry.Cell = GetCell(Location.X, Location.Y);
+
+		// Combat collision is done against the mesh, which can reach outside the capsule (e.g. large creatures)
+		USkeletalMeshComponent* MeshComp = Character->GetMesh();
+		if (MeshComp && MeshComp->IsRegistered())
+		{
+			Entry.Bounds += MeshComp->Bounds.GetBox();
+		}
+
+		// The grid is only rebuilt once per frame, so leave room for the character to move after the rebuild
+		float MaxSpeed = Character->GetVelocity().Size();
+		UCharacterMovementComponent* MoveComp = Character->GetCharacterMovement();
+		if (MoveComp)
+		{
+			MaxSpeed = FMath::Max(MaxSpeed, MoveComp->GetMaxSpeed());
+		}
+		Entry.Bounds = Entry.Bounds.ExpandBy(MaxSpeed * DeltaSeconds);
+
+		Entries.Add(Entry);
+
+		const float EntryExtent = FMath::Max(
+			FMath::Max(Entry.Bounds.Max.X - Location.X, Location.X - Entry.Bounds.Min.X),
+			FMath::Max(Entry.Bounds.Max.Y - Location.Y, Location.Y - Entry.Bounds.Min.Y));
+		MaxEntryExtent = FMath::Max(MaxEntryExtent, EntryExtent);
+	}
+
+	Entries.Sort([](const FEntry& A, const FEntry& B)
+	{
+		return A.Cell.X != B.Cell.X ? A.Cell.X < B.Cell.X : A.Cell.Y < B.Cell.Y;
+	});
+
+	const int32 NumEntries = Entries.Num();
+	int32 RangeStart = 0;
+	while (RangeStart < NumEntries)
+	{
+		const FIntPoint& Cell = Entries[RangeStart].Cell;
+		int32 RangeEnd = RangeStart + 1;
+		while (RangeEnd < NumEntries && Entries[RangeEnd].Cell == Cell)
+		{
+			RangeEnd++;
+		}
+
+		CellRanges.Add(Cell, FIntPoint(RangeStart, RangeEnd - RangeStart));
+		RangeStart = RangeEnd;
+	}
+}
+
+bool FCharacterSpatialHash::ExpandEntryBounds(const AEODCharacterBase* Character, const FBox& Bounds, FBox& OutOldBounds)
+{
+	FEntry* Entry = FindEntry(Character);
+	if (!Entry)
+	{
+		return false;
+	}
+
+	OutOldBounds = Entry->Bounds;
+	Entry->Bounds += Bounds;
+
+	// The entry stays in the cell of its actor, so queries have to reach further to find the expanded bounds.
+	// MaxEntryExtent is not shrunk back on restore, which only makes queries slightly more conservative until the next rebuild
+	const FVector Location = Character->GetActorLocation();
+	const float EntryExtent = FMath::Max(
+		FMath::Max(Entry->Bounds.Max.X - Location.X, Location.X - Entry->Bounds.Min.X),
+		FMath::Max(Entry->Bounds.Max.Y - Location.Y, Location.Y - Entry->Bounds.Min.Y));
+	MaxEntryExtent = FMath::Max(MaxEntryExtent, EntryExtent);
+	return true;
+}
+
+void FCharacterSpatialHash::RestoreEntryBounds(const AEODCharacterBase* Character, const FBox& OldBounds)
+{
+	FEntry* Entry = FindEntry(Character);
+	if (Entry)
+	{
+		Entry->Bounds = OldBounds;
+	}
+}
+
+FCharacterSpatialHash::FEntry* FCharacterSpatialHash::FindEntry(const AEODCharacterBase* Character)
+{
+	if (!Character)
+	{
+		return nullptr;
+	}
+
+	// Look in the cell of the character first. It can only be elsewhere if the actor moved since the last rebuild
+	const FVector Location = Character->GetActorLocation();
+	const FIntPoint* Range = CellRanges.Find(GetCell(Location.X, Location.Y));
+	if (Range)
+	{
+		const int32 RangeEnd = Range->X + Range->Y;
+		for (int32 Index = Range->X; Index < RangeEnd; Index++)
+		{
+			if (Entries[Index].Character == Character)
+			{
+				return &Entries[Index];
+			}
+		}
+	}
+
+	for (FEntry& Entry : Entries)
+	{
+		if (Entry.Character == Character)
+		{
+			return &Entry;
+		}
+	}
+
+	return nullptr;
+}
+
+bool FCharacterSpatialHash::PassesFilter(const FEntry& Entry, const FCharacterQueryFilter& Filter)
+{
+	if (Entry.Character == Filter.IgnoredActor)
+	{
+		return false;
+	}
+
+	if (Filter.EnemiesOf && (Entry.Character == Filter.EnemiesOf || Entry.Faction == Filter.EnemiesOf->GetFaction()))
+	{
+		return false;
+	}
+
+	return true;
+}
+
+template<typename VisitorType>
+void FCharacterSpatialHash::VisitCandidates(const FBox& QueryBounds, const FCharacterQueryFilter& Filter, VisitorType Visitor) const
+{
+	const FIntPoint MinCell = GetCell(QueryBounds.Min.X - MaxEntryExtent, QueryBounds.Min.Y - MaxEntryExtent);
+	const FIntPoint MaxCell = GetCell(QueryBounds.Max.X + MaxEntryExtent, QueryBounds.Max.Y + MaxEntryExtent);
+
+	// If the query covers more cells than there are entries, a linear scan is cheaper than the cell lookups
+	const int64 NumCells = int64(MaxCell.X - MinCell.X + 1) * int64(MaxCell.Y - MinCell.Y + 1);
+	if (NumCells > Entries.Num())
+	{
+		for (const FEntry& Entry : Entries)
+		{
+			if (PassesFilter(Entry, Filter) && QueryBounds.Intersect(Entry.Bounds) && !Visitor(Entry))
+			{
+				return;
+			}
+		}
+		return;
+	}
+
+	for (int32 CellX = MinCell.X; CellX <= MaxCell.X; CellX++)
+	{
+		for (int32 CellY = MinCell.Y; CellY <= MaxCell.Y; CellY++)
+		{
+			const FIntPoint* Range = CellRanges.Find(FIntPoint(CellX, CellY));
+			if (!Range)
+			{
+				continue;
+			}
+
+			const int32 RangeEnd = Range->X + Range->Y;
+			for (int32 Index = Range->X; Index < RangeEnd; Index++)
+			{
+				const FEntry& Entry = Entries[Index];
+				if (PassesFilter(Entry, Filter) && QueryBounds.Intersect(Entry.Bounds) && !Visitor(Entry))
+				{
+					return;
+				}
+			}
+		}
+	}
+}
+
+bool FCharacterSpatialHash::QuerySphere(const FVector& Center, float Radius, const FCharacterQueryFilter& Filter, TArray<AEODCharacterBase*>& OutCharacters) const
+{
+	OutCharacters.Reset();
+	const float RadiusSquared = Radius * Radius;
+	VisitCandidates(FBox(Center - FVector(Radius), Center + FVector(Radius)), Filter, [&](const FEntry& Entry)
+	{
+		if (FMath::SphereAABBIntersection(Center, RadiusSquared, Entry.Bounds))
+		{
+			OutCharacters.Add(Entry.Character);
+		}
+		return true;
+	});
+	return OutCharacters.Num() > 0;
+}
+
+bool FCharacterSpatialHash::QueryCapsule(const FVector& Center, const FQuat& Rotation, float Radius, float HalfHeight, const FCharacterQueryFilter& Filter, TArray<AEODCharacterBase*>& OutCharacters) const
+{
+	OutCharacters.Reset();
+	VisitCandidates(GetCapsuleBounds(Center, Rotation, Radius, HalfHeight), Filter, [&](const FEntry& Entry)
+	{
+		OutCharacters.Add(Entry.Character);
+		return true;
+	});
+	return OutCharacters.Num() > 0;
+}
+
+bool FCharacterSpatialHash::QueryBox(const FVector& Center, const FQuat& Rotation, const FVector& HalfExtent, const FCharacterQueryFilter& Filter, TArray<AEODCharacterBase*>& OutCharacters) const
+{
+	OutCharacters.Reset();
+	VisitCandidates(GetBoxBounds(Center, Rotation, HalfExtent), Filter, [&](const FEntry& Entry)
+	{
+		OutCharacters.Add(Entry.Character);
+		return true;
+	});
+	return OutCharacters.Num() > 0;
+}
+
+bool FCharacterSpatialHash::AnyInSphere(const FVector& Center, float Radius, const FCharacterQueryFilter& Filter) const
+{
+	bool bFound = false;
+	const float RadiusSquared = Radius * Radius;
+	VisitCandidates(FBox(Center - FVector(Radius), Center + FVector(Radius)), Filter, [&](const FEntry& Entry)
+	{
+		bFound = FMath::SphereAABBIntersection(Center, RadiusSquared, Entry.Bounds);
+		return !bFound;
+	});
+	return bFound;
+}
+
+bool FCharacterSpatialHash::AnyInCapsule(const FVector& Center, const FQuat& Rotation, float Radius, float HalfHeight, const FCharacterQueryFilter& Filter) const
+{
+	bool bFound = false;
+	VisitCandidates(GetCapsuleBounds(Center, Rotation, Radius, HalfHeight), Filter, [&](const FEntry& Entry)
+	{
+		bFound = true;
+		return false;
+	});
+	return bFound;
+}
+
+bool FCharacterSpatialHash::AnyInBox(const FVector& Center, const FQuat& Rotation, const FVector& HalfExtent, const FCharacterQueryFilter& Filter) const
+{
+	bool bFound = false;
+	VisitCandidates(GetBoxBounds(Center, Rotation, HalfExtent), Filter, [&](const FEntry& Entry)
+	{
+		bFound = true;
+		return false;
+	});
+	return bFound;
+}
+
+FBox FCharacterSpatialHash::GetCapsuleBounds(const FVector& Center, const FQuat& Rotation, float Radius, float HalfHeight)
+{
+	// HalfHeight includes the hemispheres, so the segment between the hemisphere centers is shorter by Radius on each side
+	const float SegmentHalfLength = FMath::Max(HalfHeight - Radius, 0.f);
+	const FVector SegmentExtent = Rotation.GetAxisZ().GetAbs() * SegmentHalfLength;
+	const FVector Extent = SegmentExtent + FVector(Radius);
+	return FBox(Center - Extent, Center + Extent);
+}
+
+FBox FCharacterSpatialHash::GetBoxBounds(const FVector& Center, const FQuat& Rotation, const FVector& HalfExtent)
+{
+	const FBox LocalBox(-HalfExtent, HalfExtent);
+	return LocalBox.TransformBy(FTransform(Rotation, Center));
+}
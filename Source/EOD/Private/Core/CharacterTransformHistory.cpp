@@ -0,0 +1,60 @@
+// Copyright 2018 Moikkai Games. All Rights Reserved.
+
+#include "CharacterTransformHistory.h"
+
+FCharacterTransformHistory::FCharacterTransformHistory() :
+	Head(Capacity - 1),
+	NumSamples(0)
+{
+}
+
+void FCharacterTransformHistory::Record(float Timestamp, const FTransform& Transform)
+{
+	// Multiple ticks with the same world time (e.g. while paused) only need the latest transform
+	if (NumSamples > 0 && Timestamps[Head] >= Timestamp)
+	{
+		Transforms[Head] = Transform;
+		return;
+	}
+
+	Head = (Head + 1) % Capacity;
+	Timestamps[Head] = Timestamp;
+	Transforms[Head] = Transform;
+	NumSamples = FMath::Min(NumSamples + 1, Capacity);
+}
+
+bool FCharacterTransformHistory::Sample(float Timestamp, FTransform& OutTransform) const
+{
+	if (NumSamples == 0)
+	{
+		return false;
+	}
+
+	if (Timestamp >= Timestamps[Head])
+	{
+		OutTransform = Transforms[Head];
+		return true;
+	}
+
+	// Walk back from the newest sample, rewinds are short so the target is usually within the last few samples
+	for (int32 Age = 1; Age < NumSamples; Age++)
+	{
+		const int32 OlderIndex = GetSampleIndex(Age);
+		if (Timestamps[OlderIndex] <= Timestamp)
+		{
+			const int32 NewerIndex = GetSampleIndex(Age - 1);
+			const float Alpha = (Timestamp - Timestamps[OlderIndex]) / (Timestamps[NewerIndex] - Timestamps[OlderIndex]);
+			OutTransform.Blend(Transforms[OlderIndex], Transforms[NewerIndex], Alpha);
+			return true;
+		}
+	}
+
+	OutTransform = Transforms[GetSampleIndex(NumSamples - 1)];
+	return true;
+}
+
+void FCharacterTransformHistory::Reset()
+{
+	Head = Capacity - 1;
+	NumSamples = 0;
+}
@@ -0,0 +1,358 @@
+// Copyright 2018 Moikkai Games. All Rights Reserved.
+
+#include "CombatBenchmarkCommandlet.h"
+#include "AICharacterBase.h"
+#include "CombatZoneModeBase.h"
+#include "CombatManager.h"
+#include "EODGameInstance.h"
+
+#include "Misc/App.h"
+#include "Misc/ConfigCacheIni.h"
+#include "Misc/FileHelper.h"
+#include "Engine/World.h"
+#include "Engine/Engine.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/StaticMeshActor.h"
+#include "Engine/GameInstance.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonWriter.h"
+#include "Serialization/JsonSerializer.h"
+#include "Components/StaticMeshComponent.h"
+#include "Components/SkeletalMeshComponent.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogCombatBenchmark, Log, All);
+
+/** Distance of the front row of every character group from the world origin */
+static const float GroupFrontDistance = 150.f;
+
+/** Distance between characters of a group */
+static const float CharacterSpacing = 150.f;
+
+/** Maximum random offset of a character from its grid position */
+static const float CharacterJitter = 25.f;
+
+static const float SpawnHeight = 150.f;
+
+UCombatBenchmarkCommandlet::UCombatBenchmarkCommandlet(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
+{
+	IsClient = false;
+	IsServer = true;
+	IsEditor = false;
+	LogToConsole = true;
+}
+
+int32 UCombatBenchmarkCommandlet::Main(const FString& Params)
+{
+	FString ClassesParam;
+	// Don't stop on separators, the class list is comma separated
+	FParse::Value(*Params, TEXT("Classes="), ClassesParam, false);
+
+	int32 CharactersPerClass = 20;
+	int32 NumTicks = 3000;
+	float TickRate = 30.f;
+	int32 Seed = 1;
+	FString GameModePath = TEXT("/Script/EOD.PVEOnlyModeBase");
+	FString OutputPath;
+	FString RecordingPath;
+	float MaxResolveMsPerRequest = 0.f;
+
+	FParse::Value(*Params, TEXT("CharactersPerClass="), CharactersPerClass);
+	FParse::Value(*Params, TEXT("Ticks="), NumTicks);
+	FParse::Value(*Params, TEXT("TickRate="), TickRate);
+	FParse::Value(*Params, TEXT("Seed="), Seed);
+	FParse::Value(*Params, TEXT("GameMode="), GameModePath);
+	FParse::Value(*Params, TEXT("Output="), OutputPath);
+	FParse::Value(*Params, TEXT("Record="), RecordingPath);
+	FParse::Value(*Params, TEXT("MaxResolveMsPerRequest="), MaxResolveMsPerRequest);
+
+	TArray<FString> ClassPaths;
+	ClassesParam.ParseIntoArray(ClassPaths, TEXT(","));
+
+	TArray<UClass*> CharacterClasses;
+	TArray<EFaction> Factions;
+	for (const FString& ClassPath : ClassPaths)
+	{
+		UClass* CharacterClass = LoadClass<AAICharacterBase>(nullptr, *ClassPath);
+		if (!CharacterClass)
+		{
+			UE_LOG(LogCombatBenchmark, Error, TEXT("Failed to load AI character class %s"), *ClassPath);
+			return 1;
+		}
+		CharacterClasses.Add(CharacterClass);
+		Factions.AddUnique(CharacterClass->GetDefaultObject<AAICharacterBase>()->GetFaction());
+	}
+
+	// AI characters only attack characters of other factions, a single faction would never land a hit
+	if (CharacterClasses.Num() > 0 && Factions.Num() < 2)
+	{
+		UE_LOG(LogCombatBenchmark, Error, TEXT("All character classes belong to the same faction. Pass classes of at least two different factions"));
+		return 1;
+	}
+
+	if (CharacterClasses.Num() == 0 || CharactersPerClass <= 0 || NumTicks <= 0 || TickRate <= 0.f)
+	{
+		UE_LOG(LogCombatBenchmark, Error, TEXT("Usage: -run=CombatBenchmark -Classes=<AI character class>[,<AI character class>...] [-CharactersPerClass=20] [-Ticks=3000] [-TickRate=30] [-Seed=1]"));
+		return 1;
+	}
+
+	// Crits and AI skill selection draw from the combat manager's FCombatRandom, which is seeded through the CombatSeed URL option
+	// in CreateBenchmarkWorld. FMath is still seeded for randomness outside of our combat code, e.g. random deviations of
+	// behavior tree waits and random nodes in character blueprints, which would otherwise make AI behavior differ between runs.
+	FMath::RandInit(Seed);
+	FMath::SRandInit(Seed);
+	FRandomStream RandomStream(Seed);
+
+	UGameInstance* GameInstance = nullptr;
+	UWorld* World = CreateBenchmarkWorld(GameModePath, Seed, GameInstance);
+	if (!World)
+	{
+		return 1;
+	}
+
+	ACombatZoneModeBase* CombatZoneGameMode = Cast<ACombatZoneModeBase>(World->GetAuthGameMode());
+	ACombatManager* CombatManager = CombatZoneGameMode ? CombatZoneGameMode->GetCombatManager() : nullptr;
+	if (!CombatManager)
+	{
+		UE_LOG(LogCombatBenchmark, Error, TEXT("Game mode %s did not spawn a combat manager"), *GameModePath);
+		DestroyBenchmarkWorld(World, GameInstance);
+		return 1;
+	}
+
+	SpawnFloor(World);
+
+	TArray<AAICharacterBase*> Characters;
+	for (int32 ClassIndex = 0; ClassIndex < CharacterClasses.Num(); ClassIndex++)
+	{
+		const float GroupAngle = 360.f * ClassIndex / CharacterClasses.Num();
+		SpawnCharacterGroup(World, CharacterClasses[ClassIndex], CharactersPerClass, GroupAngle, RandomStream, Characters);
+	}
+
+	UE_LOG(LogCombatBenchmark, Display, TEXT("Spawned %d characters of %d classes. Simulating %d ticks at %.1f Hz with seed %d"),
+		Characters.Num(), CharacterClasses.Num(), NumTicks, TickRate, Seed);
+
+	CombatManager->ResetStatistics();
+	if (!RecordingPath.IsEmpty())
+	{
+		CombatManager->StartCombatRecording();
+	}
+
+	const uint64 UsedPhysicalBefore = FPlatformMemory::GetStats().UsedPhysical;
+	uint64 PeakUsedPhysical = UsedPhysicalBefore;
+	const int32 MemorySampleInterval = FMath::Max(FMath::RoundToInt(TickRate), 1);
+
+	const float DeltaTime = 1.f / TickRate;
+	const double StartTime = FPlatformTime::Seconds();
+
+	for (int32 TickIndex = 0; TickIndex < NumTicks; TickIndex++)
+	{
+		FApp::SetDeltaTime(DeltaTime);
+		FApp::SetCurrentTime(FApp::GetCurrentTime() + DeltaTime);
+
+		World->Tick(LEVELTICK_All, DeltaTime);
+
+		// Nothing else advances the frame counter in a commandlet, and the character spatial hash is rebuilt once per frame
+		GFrameCounter++;
+
+		if (TickIndex % MemorySampleInterval == 0)
+		{
+			PeakUsedPhysical = FMath::Max(PeakUsedPhysical, (uint64)FPlatformMemory::GetStats().UsedPhysical);
+		}
+	}
+
+	const double WallSeconds = FPlatformTime::Seconds() - StartTime;
+	const double SimulatedSeconds = NumTicks * DeltaTime;
+	const FCombatManagerStatistics& Statistics = CombatManager->GetStatistics();
+
+	const double ResolveMsPerRequest = Statistics.NumMeleeRequests > 0 ? Statistics.ResolveSeconds * 1000.0 / Statistics.NumMeleeRequests : 0.0;
+	const double HitsPerSimulatedSecond = Statistics.NumAttacksReceived / SimulatedSeconds;
+	const double HitsPerWallSecond = WallSeconds > 0.0 ? Statistics.NumAttacksReceived / WallSeconds : 0.0;
+	const int32 NumAttacksReceived = Statistics.NumAttacksReceived;
+
+	int32 NumAlive = 0;
+	for (AAICharacterBase* Character : Characters)
+	{
+		if (IsValid(Character) && Character->IsAlive())
+		{
+			NumAlive++;
+		}
+	}
+
+	UE_LOG(LogCombatBenchmark, Display, TEXT("Wall time: %.3f s (%.3f ms per tick)"), WallSeconds, WallSeconds * 1000.0 / NumTicks);
+	UE_LOG(LogCombatBenchmark, Display, TEXT("Hits: %d (%.2f per simulated second, %.2f per wall second)"), Statistics.NumAttacksReceived, HitsPerSimulatedSecond, HitsPerWallSecond);
+	UE_LOG(LogCombatBenchmark, Display, TEXT("Melee requests: %d, resolve time: %.3f ms total, %.4f ms per request"), Statistics.NumMeleeRequests, Statistics.ResolveSeconds * 1000.0, ResolveMsPerRequest);
+	UE_LOG(LogCombatBenchmark, Display, TEXT("Physics queries: %d combat sweeps, %d line traces"), Statistics.NumCombatSweeps, Statistics.NumLineTraces);
+	UE_LOG(LogCombatBenchmark, Display, TEXT("Memory: %.2f MB used physical before, %.2f MB peak, %u bytes peak combat buffers"),
+		UsedPhysicalBefore / (1024.0 * 1024.0), PeakUsedPhysical / (1024.0 * 1024.0), Statistics.PeakBuffersSize);
+	UE_LOG(LogCombatBenchmark, Display, TEXT("Characters alive: %d of %d"), NumAlive, Characters.Num());
+
+	if (!OutputPath.IsEmpty())
+	{
+		TSharedRef<FJsonObject> Report = MakeShareable(new FJsonObject);
+		Report->SetNumberField(TEXT("Seed"), Seed);
+		Report->SetNumberField(TEXT("Characters"), Characters.Num());
+		Report->SetNumberField(TEXT("Ticks"), NumTicks);
+		Report->SetNumberField(TEXT("TickRate"), TickRate);
+		Report->SetNumberField(TEXT("WallSeconds"), WallSeconds);
+		Report->SetNumberField(TEXT("Hits"), Statistics.NumAttacksReceived);
+		Report->SetNumberField(TEXT("HitsPerSimulatedSecond"), HitsPerSimulatedSecond);
+		Report->SetNumberField(TEXT("HitsPerWallSecond"), HitsPerWallSecond);
+		Report->SetNumberField(TEXT("MeleeRequests"), Statistics.NumMeleeRequests);
+		Report->SetNumberField(TEXT("ResolveMsPerRequest"), ResolveMsPerRequest);
+		Report->SetNumberField(TEXT("CombatSweeps"), Statistics.NumCombatSweeps);
+		Report->SetNumberField(TEXT("LineTraces"), Statistics.NumLineTraces);
+		Report->SetNumberField(TEXT("UsedPhysicalBefore"), (double)UsedPhysicalBefore);
+		Report->SetNumberField(TEXT("PeakUsedPhysical"), (double)PeakUsedPhysical);
+		Report->SetNumberField(TEXT("PeakCombatBuffersSize"), Statistics.PeakBuffersSize);
+		Report->SetNumberField(TEXT("CharactersAlive"), NumAlive);
+
+		FString ReportString;
+		TSharedRef<TJsonWriter<>> JsonWriter = TJsonWriterFactory<>::Create(&ReportString);
+		FJsonSerializer::Serialize(Report, JsonWriter);
+		if (!FFileHelper::SaveStringToFile(ReportString, *OutputPath))
+		{
+			UE_LOG(LogCombatBenchmark, Error, TEXT("Failed to write report to %s"), *OutputPath);
+		}
+	}
+
+	if (!RecordingPath.IsEmpty())
+	{
+		if (CombatManager->GetCombatRecorder().GetNumDroppedEvents() > 0)
+		{
+			UE_LOG(LogCombatBenchmark, Warning, TEXT("Combat recording buffer was full, %d oldest events were dropped"), CombatManager->GetCombatRecorder().GetNumDroppedEvents());
+		}
+		if (!CombatManager->SaveCombatRecording(RecordingPath))
+		{
+			UE_LOG(LogCombatBenchmark, Error, TEXT("Failed to write combat recording to %s"), *RecordingPath);
+		}
+	}
+
+	DestroyBenchmarkWorld(World, GameInstance);
+
+	if (NumAttacksReceived == 0)
+	{
+		UE_LOG(LogCombatBenchmark, Error, TEXT("No attack landed during the benchmark, there was no combat to measure"));
+		return 3;
+	}
+
+	if (MaxResolveMsPerRequest > 0.f && ResolveMsPerRequest > MaxResolveMsPerRequest)
+	{
+		UE_LOG(LogCombatBenchmark, Error, TEXT("Resolve time of %.4f ms per request exceeds the limit of %.4f ms"), ResolveMsPerRequest, MaxResolveMsPerRequest);
+		return 2;
+	}
+
+	return 0;
+}
+
+UWorld* UCombatBenchmarkCommandlet::CreateBenchmarkWorld(const FString& GameModePath, int32 CombatSeed, UGameInstance*& OutGameInstance) const
+{
+	// Use the project's game instance since AI stats are loaded from data tables referenced by it
+	FString GameInstanceClassPath;
+	GConfig->GetString(TEXT("/Script/EngineSettings.GameMapsSettings"), TEXT("GameInstanceClass"), GameInstanceClassPath, GEngineIni);
+	UClass* GameInstanceClass = GameInstanceClassPath.IsEmpty() ? nullptr : LoadClass<UGameInstance>(nullptr, *GameInstanceClassPath);
+	if (!GameInstanceClass)
+	{
+		GameInstanceClass = UEODGameInstance::StaticClass();
+	}
+
+	UGameInstance* GameInstance = NewObject<UGameInstance>(GEngine, GameInstanceClass);
+	GameInstance->AddToRoot();
+	GameInstance->InitializeStandalone();
+
+	UWorld* World = GameInstance->GetWorld();
+	check(World);
+
+	FURL URL;
+	URL.AddOption(*(FString(TEXT("game=")) + GameModePath));
+	URL.AddOption(*FString::Printf(TEXT("CombatSeed=%d"), CombatSeed));
+
+	World->SetGameMode(URL);
+	if (!World->GetAuthGameMode())
+	{
+		UE_LOG(LogCombatBenchmark, Error, TEXT("Failed to create game mode %s"), *GameModePath);
+		DestroyBenchmarkWorld(World, GameInstance);
+		return nullptr;
+	}
+
+	World->InitializeActorsForPlay(URL);
+	World->BeginPlay();
+
+	OutGameInstance = GameInstance;
+	return World;
+}
+
+void UCombatBenchmarkCommandlet::DestroyBenchmarkWorld(UWorld* World, UGameInstance* GameInstance) const
+{
+	World->BeginTearingDown();
+	GameInstance->Shutdown();
+
+	World->DestroyWorld(false);
+	GEngine->DestroyWorldContext(World);
+
+	GameInstance->RemoveFromRoot();
+	CollectGarbage(RF_NoFlags);
+}
+
+void UCombatBenchmarkCommandlet::SpawnFloor(UWorld* World) const
+{
+	UStaticMesh* CubeMesh = LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Cube.Cube"));
+	AStaticMeshActor* Floor = World->SpawnActor<AStaticMeshActor>(FVector(0.f, 0.f, -50.f), FRotator::ZeroRotator);
+	if (!CubeMesh || !Floor)
+	{
+		UE_LOG(LogCombatBenchmark, Warning, TEXT("Failed to spawn the floor, characters will fall"));
+		return;
+	}
+
+	// Static components can't have their mesh changed once registered
+	Floor->SetMobility(EComponentMobility::Movable);
+	Floor->GetStaticMeshComponent()->SetStaticMesh(CubeMesh);
+	Floor->SetActorScale3D(FVector(200.f, 200.f, 1.f));
+}
+
+void UCombatBenchmarkCommandlet::SpawnCharacterGroup(
+	UWorld* World,
+	UClass* CharacterClass,
+	int32 NumCharacters,
+	float GroupAngle,
+	FRandomStream& RandomStream,
+	TArray<AAICharacterBase*>& OutCharacters) const
+{
+	const int32 NumColumns = FMath::CeilToInt(FMath::Sqrt((float)NumCharacters));
+	const FVector GroupDirection = FRotator(0.f, GroupAngle, 0.f).Vector();
+	const FVector RightDirection = FVector::CrossProduct(FVector::UpVector, GroupDirection);
+	const FRotator FacingRotation = (-GroupDirection).Rotation();
+
+	FActorSpawnParameters SpawnInfo;
+	SpawnInfo.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+
+	for (int32 Index = 0; Index < NumCharacters; Index++)
+	{
+		const int32 Row = Index / NumColumns;
+		const int32 Column = Index % NumColumns;
+
+		FVector Location =
+			GroupDirection * (GroupFrontDistance + Row * CharacterSpacing) +
+			RightDirection * ((Column - (NumColumns - 1) * 0.5f) * CharacterSpacing);
+		Location.X += RandomStream.FRandRange(-CharacterJitter, CharacterJitter);
+		Location.Y += RandomStream.FRandRange(-CharacterJitter, CharacterJitter);
+		Location.Z = SpawnHeight;
+
+		AAICharacterBase* Character = World->SpawnActor<AAICharacterBase>(CharacterClass, Location, FacingRotation, SpawnInfo);
+		if (!Character)
+		{
+			continue;
+		}
+
+		if (!Character->GetController())
+		{
+			Character->SpawnDefaultController();
+		}
+
+		// Nothing is rendered in a headless run, but notifies still have to fire and sockets have to follow the animation
+		if (Character->GetMesh())
+		{
+			Character->GetMesh()->VisibilityBasedAnimTickOption = EVisibilityBasedAnimTickOption::AlwaysTickPoseAndRefreshBones;
+		}
+
+		OutCharacters.Add(Character);
+	}
+}
@@ -8,25 +8,114 @@
 #include "EODAIControllerBase.h"
 #include "EODPlayerController.h"
 
+#include "Misc/Paths.h"
 #include "Engine/World.h"
 #include "Components/PrimitiveComponent.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "GameFramework/PlayerState.h"
+
+DECLARE_CYCLE_STAT(TEXT("EOD ResolveMeleeAttacks"), STAT_EODResolveMeleeAttacks, STATGROUP_EOD);
+DECLARE_CYCLE_STAT(TEXT("EOD RewindCharacters"), STAT_EODRewindCharacters, STATGROUP_EOD);
+DECLARE_MEMORY_STAT(TEXT("EOD Combat Buffers Memory"), STAT_EODCombatBuffersMemory, STATGROUP_EOD);
 
 ACombatManager::ACombatManager(const FObjectInitializer & ObjectInitializer) : Super(ObjectInitializer)
 {
-	PrimaryActorTick.bCanEverTick = false;
+	// The combat manager only ticks while there are melee hit requests waiting to be resolved
+	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.bStartWithTickEnabled = false;
+	// Resolve hits after animations (and hence collision notifies) have been processed for the frame
+	PrimaryActorTick.TickGroup = TG_PostUpdateWork;
 
 	SetReplicates(false);
 	SetReplicateMovement(false);
+
+	bUseAsyncLineTraces = false;
+	bEnableLagCompensation = true;
+	MaxRewindTime = 0.25f;
+	RewindRadius = 1500.f;
+	bRecordCombat = false;
+	CombatRecordingBufferSize = 4 * 1024 * 1024;
+	TargetSnapshotsFrame = MAX_uint64;
+	LastSwingId = 0;
+	FirstDeferredSequence = 0;
+	RewoundTimestamp = 0.f;
+	LineTraceDelegate.BindUObject(this, &ACombatManager::OnLineTraceCompleted);
 }
 
 void ACombatManager::BeginPlay()
 {
 	Super::BeginPlay();
+
+	if (bRecordCombat)
+	{
+		StartCombatRecording();
+	}
+}
+
+void ACombatManager::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (bRecordCombat && CombatRecorder.IsRecording())
+	{
+		const FString Filename = FPaths::ProjectSavedDir() / TEXT("CombatRecordings") / FString::Printf(TEXT("Combat_%s.eodcombat"), *FDateTime::Now().ToString());
+		SaveCombatRecording(Filename);
+	}
+
+	Super::EndPlay(EndPlayReason);
 }
 
 void ACombatManager::Tick(float DeltaTime)
 {
 	Super::Tick(DeltaTime);
+
+	const double ResolveStartTime = FPlatformTime::Seconds();
+
+	// Traces requested in this tick group are only kicked off next frame, and their delegates fire at the start of the frame after that.
+	// So only the attacks whose traces have completed are resolved here, and the rest wait for a later tick.
+	ResolveDeferredMeleeAttacks();
+	ResolvePendingMeleeAttacks();
+
+	Statistics.ResolveSeconds += FPlatformTime::Seconds() - ResolveStartTime;
+
+	// The hit pipeline only works on these reused buffers, so this should stay flat once the buffers have grown to fit the heaviest frame
+	const uint32 BuffersSize = GetCombatBuffersAllocatedSize();
+	SET_MEMORY_STAT(STAT_EODCombatBuffersMemory, BuffersSize);
+	Statistics.PeakBuffersSize = FMath::Max(Statistics.PeakBuffersSize, BuffersSize);
+
+	if (DeferredMeleeAttacks.Num() == 0)
+	{
+		SetActorTickEnabled(false);
+	}
+}
+
+void ACombatManager::QueueMeleeAttack(
+	AActor* HitInstigator,
+	const bool bHit,
+	const TArray<FHitResult>& HitResults,
+	const FCollisionSkillInfo& CollisionSkillInfo,
+	const uint32 SwingId)
+{
+	if (!HitInstigator)
+	{
+		return;
+	}
+
+	FMeleeHitRequest Request;
+	Request.HitInstigator = HitInstigator;
+	Request.CollisionSkillInfo = CollisionSkillInfo;
+	Request.SwingId = SwingId;
+	// Collision notifies queue their requests from inside their rewind scope
+	Request.RewindTimestamp = RewoundCharacters.Num() > 0 ? RewoundTimestamp : -1.f;
+	Request.FirstHitIndex = PendingHitResults.Num();
+	Request.NumHits = HitResults.Num();
+
+	PendingHitResults.Append(HitResults);
+	PendingMeleeRequests.Add(Request);
+	Statistics.NumMeleeRequests++;
+
+	if (!IsActorTickEnabled())
+	{
+		SetActorTickEnabled(true);
+	}
 }
 
 void ACombatManager::OnMeleeAttack(
@@ -43,19 +132,139 @@ void ACombatManager::OnMeleeAttack(
 
 	TArray<FAttackResponse> AttackResponses;
 	TArray<AActor*> HitActors;
-	if (HitResults.Num() == 0)
+	// Callers that rewind characters resolve the attack from inside their rewind scope, so there is nothing to rewind here
+	ResolveMeleeSwing(HitInstigator, InstigatorCI, CollisionSkillInfo, HitResults.GetData(), HitResults.Num(), -1.f, false, AttackResponses, HitActors);
+	InstigatorCI->PostAttack(AttackResponses, HitActors);
+}
+
+void ACombatManager::ResolvePendingMeleeAttacks()
+{
+	SCOPE_CYCLE_COUNTER(STAT_EODResolveMeleeAttacks);
+
+	if (PendingMeleeRequests.Num() == 0)
+	{
+		return;
+	}
+
+	// Group the requests by instigator. Stable sort keeps the capsules of a single swing next to each other
+	PendingMeleeRequests.StableSort([](const FMeleeHitRequest& A, const FMeleeHitRequest& B)
+	{
+		return A.HitInstigator.Get() < B.HitInstigator.Get();
+	});
+
+	const int32 NumRequests = PendingMeleeRequests.Num();
+	int32 RequestIndex = 0;
+	while (RequestIndex < NumRequests)
+	{
+		const FMeleeHitRequest& FirstRequest = PendingMeleeRequests[RequestIndex];
+		AActor* HitInstigator = FirstRequest.HitInstigator.Get();
+
+		// Find the end of this instigator's requests
+		int32 InstigatorEnd = RequestIndex + 1;
+		while (InstigatorEnd < NumRequests && PendingMeleeRequests[InstigatorEnd].HitInstigator.Get() == HitInstigator)
+		{
+			InstigatorEnd++;
+		}
+
+		// The instigator might have been destroyed since its requests were queued
+		ICombatInterface* InstigatorCI = Cast<ICombatInterface>(HitInstigator);
+		if (!HitInstigator || !InstigatorCI)
+		{
+			RequestIndex = InstigatorEnd;
+			continue;
+		}
+
+		ScratchAttackResponses.Reset();
+		ScratchHitActors.Reset();
+		const int32 NumDeferredBefore = DeferredMeleeAttacks.Num();
+
+		while (RequestIndex < InstigatorEnd)
+		{
+			const FMeleeHitRequest& SwingRequest = PendingMeleeRequests[RequestIndex];
+
+			// Consecutive requests with the same swing id come from the capsules of one swing.
+			// Since their hit results are stored contiguously, the whole swing can be resolved as a single hit list.
+			int32 SwingEnd = RequestIndex + 1;
+			int32 NumSwingHits = SwingRequest.NumHits;
+			while (SwingEnd < InstigatorEnd &&
+				PendingMeleeRequests[SwingEnd].SwingId == SwingRequest.SwingId &&
+				PendingMeleeRequests[SwingEnd].FirstHitIndex == SwingRequest.FirstHitIndex + NumSwingHits)
+			{
+				NumSwingHits += PendingMeleeRequests[SwingEnd].NumHits;
+				SwingEnd++;
+			}
+
+			const FHitResult* SwingHitResults = PendingHitResults.GetData() + SwingRequest.FirstHitIndex;
+			ResolveMeleeSwing(HitInstigator, InstigatorCI, SwingRequest.CollisionSkillInfo, SwingHitResults, NumSwingHits, SwingRequest.RewindTimestamp, bUseAsyncLineTraces, ScratchAttackResponses, ScratchHitActors);
+
+			RequestIndex = SwingEnd;
+		}
+
+		// If any of the attacks got deferred, PostAttack will be called once their line traces complete
+		if (DeferredMeleeAttacks.Num() == NumDeferredBefore)
+		{
+			InstigatorCI->PostAttack(ScratchAttackResponses, ScratchHitActors);
+		}
+	}
+
+	// Keep the allocations around for the next frame
+	PendingMeleeRequests.Reset();
+	PendingHitResults.Reset();
+}
+
+void ACombatManager::ResolveMeleeSwing(
+	AActor* HitInstigator,
+	ICombatInterface* InstigatorCI,
+	const FCollisionSkillInfo& CollisionSkillInfo,
+	const FHitResult* HitResults,
+	const int32 NumHits,
+	const float RewindTimestamp,
+	const bool bDeferAttacks,
+	TArray<FAttackResponse>& OutAttackResponses,
+	TArray<AActor*>& OutHitActors)
+{
+	check(HitInstigator && InstigatorCI);
+	if (NumHits == 0)
+	{
+		return;
+	}
+
+	FAttackInfo AttackInfo;
+	if (!InstigatorCI->GetAttackInfo(CollisionSkillInfo.SkillGroup, CollisionSkillInfo.CollisionIndex, AttackInfo))
 	{
-		InstigatorCI->PostAttack(AttackResponses, HitActors);
 		return;
 	}
 
-	TSharedPtr<FAttackInfo> AttackInfoPtr = InstigatorCI->GetAttackInfoPtr(CollisionSkillInfo.SkillGroup, CollisionSkillInfo.CollisionIndex);
-	TArray<TSharedPtr<FAttackResponse>> AttackResponsePtrs;
-	for (const FHitResult& HitResult : HitResults)
+	if (CombatRecorder.IsRecording())
+	{
+		FCombatHitRequestRecord Record;
+		Record.Timestamp = GetWorld()->GetTimeSeconds();
+		Record.InstigatorId = HitInstigator->GetUniqueID();
+		Record.SkillGroupHash = FCrc::StrCrc32(*CollisionSkillInfo.SkillGroup.ToString());
+		Record.CollisionIndex = CollisionSkillInfo.CollisionIndex;
+		Record.NumHits = NumHits;
+		CombatRecorder.RecordHitRequest(Record);
+	}
+
+	// Collect the targets of the swing first, so that all of their line traces can be done inside a single rewind
+	ScratchSwingTargets.Reset();
+	for (int32 HitIndex = 0; HitIndex < NumHits; HitIndex++)
 	{
+		const FHitResult& HitResult = HitResults[HitIndex];
 		AActor* HitActor = HitResult.GetActor();
-		// Multiple components of an actor can register multiple hits. We want to avoid damaging the same actor more than one time
-		if (HitActors.Contains(HitActor))
+
+		// Multiple components of an actor, or multiple capsules of the same swing, can register multiple hits.
+		// We want to avoid damaging the same actor more than one time
+		bool bAlreadyHit = false;
+		for (const FMeleeSwingTarget& SwingTarget : ScratchSwingTargets)
+		{
+			if (SwingTarget.HitActor == HitActor)
+			{
+				bAlreadyHit = true;
+				break;
+			}
+		}
+		if (bAlreadyHit)
 		{
 			continue;
 		}
@@ -63,44 +272,283 @@ void ACombatManager::OnMeleeAttack(
 		ICombatInterface* TargetCI = Cast<ICombatInterface>(HitActor);
 
 		// Do not process if the hit actor does not implement a combat interface
-		if (!TargetCI)
+		if (!TargetCI || !InstigatorCI->IsEnemyOf(TargetCI))
 		{
 			continue;
 		}
 
-		TSharedPtr<FAttackResponse> AttackResponsePtr = ProcessAttack(HitInstigator, InstigatorCI, AttackInfoPtr, HitActor, TargetCI, HitResult);
-		if (AttackResponsePtr.IsValid())
+		FMeleeSwingTarget& SwingTarget = ScratchSwingTargets[ScratchSwingTargets.AddDefaulted()];
+		SwingTarget.HitActor = HitActor;
+		SwingTarget.TargetCI = TargetCI;
+		SwingTarget.HitResult = &HitResult;
+		SwingTarget.bLineHitResultFound = false;
+	}
+
+	if (ScratchSwingTargets.Num() == 0)
+	{
+		return;
+	}
+
+	// The line traces have to see the targets where the collision test of the swing saw them
+	const bool bRewound = RewindTimestamp >= 0.f && RewindCharacters(HitInstigator, RewindTimestamp);
+	for (FMeleeSwingTarget& SwingTarget : ScratchSwingTargets)
+	{
+		if (bDeferAttacks)
+		{
+			DeferMeleeAttack(HitInstigator, AttackInfo, SwingTarget.HitActor, *SwingTarget.HitResult, bRewound);
+			OutHitActors.Add(SwingTarget.HitActor);
+		}
+		else
+		{
+			GetLineHitResult(HitInstigator, SwingTarget.HitResult->GetComponent(), SwingTarget.LineHitResult, SwingTarget.bLineHitResultFound);
+		}
+	}
+	if (bRewound)
+	{
+		RestoreRewoundCharacters();
+	}
+
+	if (bDeferAttacks)
+	{
+		return;
+	}
+
+	// Damage goes through the same batch calculation as deferred attacks, so both paths give identical results
+	SwingDamageBatch.Reset();
+	for (FMeleeSwingTarget& SwingTarget : ScratchSwingTargets)
+	{
+		const AEODCharacterBase* HitCharacter = Cast<AEODCharacterBase>(SwingTarget.HitActor);
+		SwingTarget.Defense = FDamageCalculator::GetDefense(HitCharacter ? HitCharacter->GetStatsComponent() : nullptr, AttackInfo.DamageType);
+		SwingTarget.AttackIndex = CombatRandom.GetNextAttackIndex();
+		SwingTarget.CritRoll = FDamageCalculator::RollCrit(CombatRandom.NextAttackStream());
+		SwingDamageBatch.AddAttack(AttackInfo, SwingTarget.Defense, SwingTarget.CritRoll);
+	}
+	SwingDamageBatch.Calculate();
+
+	for (int32 Index = 0; Index < ScratchSwingTargets.Num(); Index++)
+	{
+		const FMeleeSwingTarget& SwingTarget = ScratchSwingTargets[Index];
+		FAttackResponse AttackResponse;
+		if (ProcessAttack(HitInstigator, InstigatorCI, AttackInfo, SwingTarget, SwingDamageBatch.GetOutcome(Index), AttackResponse))
 		{
-			AttackResponsePtrs.Add(AttackResponsePtr);
-			HitActors.Add(HitActor);
-			FAttackResponse* ResponsePtr = AttackResponsePtr.Get();
-			if (ResponsePtr)
+			OutHitActors.Add(SwingTarget.HitActor);
+			OutAttackResponses.Add(AttackResponse);
+		}
+	}
+}
+
+void ACombatManager::DeferMeleeAttack(AActor* HitInstigator, const FAttackInfo& AttackInfo, AActor* HitTarget, const FHitResult& HitResult, const bool bSyncLineTrace)
+{
+	UWorld* World = GetWorld();
+	const UPrimitiveComponent* HitComponent = HitResult.GetComponent();
+	check(World);
+
+	const int32 DeferredIndex = DeferredMeleeAttacks.AddDefaulted();
+	FDeferredMeleeAttack& DeferredAttack = DeferredMeleeAttacks[DeferredIndex];
+	DeferredAttack.HitInstigator = HitInstigator;
+	DeferredAttack.HitTarget = HitTarget;
+	DeferredAttack.AttackInfo = AttackInfo;
+	DeferredAttack.HitResult = HitResult;
+	DeferredAttack.bLineHitResultFound = false;
+	DeferredAttack.bTraceCompleted = false;
+	DeferredAttack.DeferredFrame = GFrameCounter;
+
+	if (!IsValid(HitComponent) || bSyncLineTrace)
+	{
+		GetLineHitResult(HitInstigator, HitComponent, DeferredAttack.LineHitResult, DeferredAttack.bLineHitResultFound);
+		DeferredAttack.bTraceCompleted = true;
+		return;
+	}
+
+	FCollisionQueryParams QueryParams = UCombatLibrary::GenerateCombatCollisionQueryParams(HitInstigator);
+	FVector LineStart = HitInstigator->GetActorLocation();
+	FVector LineEnd = HitComponent->GetComponentLocation();
+	LineEnd.Z = LineStart.Z < LineEnd.Z ? LineStart.Z : LineEnd.Z;
+
+	// User data is used to find the deferred attack once the trace completes, even if earlier attacks have been resolved by then
+	const uint32 UserData = FirstDeferredSequence + (uint32)DeferredIndex;
+	Statistics.NumLineTraces++;
+	DeferredAttack.TraceHandle = World->AsyncLineTraceByChannel(
+		EAsyncTraceType::Multi,
+		LineStart,
+		LineEnd,
+		COLLISION_COMBAT,
+		QueryParams,
+		FCollisionResponseParams::DefaultResponseParam,
+		&LineTraceDelegate,
+		UserData);
+}
+
+void ACombatManager::OnLineTraceCompleted(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum)
+{
+	// Wraps around correctly since both are unsigned. Attacks that were already resolved get an index outside the array
+	const int32 Index = (int32)(TraceDatum.UserData - FirstDeferredSequence);
+	if (!DeferredMeleeAttacks.IsValidIndex(Index) || DeferredMeleeAttacks[Index].TraceHandle != TraceHandle)
+	{
+		return;
+	}
+
+	FDeferredMeleeAttack& DeferredAttack = DeferredMeleeAttacks[Index];
+	DeferredAttack.bTraceCompleted = true;
+	const UPrimitiveComponent* HitComponent = DeferredAttack.HitResult.GetComponent();
+	for (FHitResult& LineHitResult : TraceDatum.OutHits)
+	{
+		if (LineHitResult.GetComponent() == HitComponent)
+		{
+			DeferredAttack.LineHitResult = LineHitResult;
+			DeferredAttack.bLineHitResultFound = true;
+			break;
+		}
+	}
+}
+
+void ACombatManager::ResolveDeferredMeleeAttacks()
+{
+	SCOPE_CYCLE_COUNTER(STAT_EODResolveMeleeAttacks);
+
+	// Traces complete in the order they were issued, so the attacks that are ready to be resolved are always at the front
+	int32 NumAttacks = 0;
+	while (NumAttacks < DeferredMeleeAttacks.Num())
+	{
+		const FDeferredMeleeAttack& DeferredAttack = DeferredMeleeAttacks[NumAttacks];
+		if (!DeferredAttack.bTraceCompleted && GFrameCounter - DeferredAttack.DeferredFrame < MaxDeferredFrames)
+		{
+			break;
+		}
+		NumAttacks++;
+	}
+
+	if (NumAttacks == 0)
+	{
+		return;
+	}
+
+	// Whether an attack is blocked is only known once the target receives it, so both outcomes are calculated for each attack
+	DeferredDamageBatch.Reset();
+	for (int32 Index = 0; Index < NumAttacks; Index++)
+	{
+		FDeferredMeleeAttack& DeferredAttack = DeferredMeleeAttacks[Index];
+		const AEODCharacterBase* HitCharacter = Cast<AEODCharacterBase>(DeferredAttack.HitTarget.Get());
+		const UStatsComponentBase* TargetStatsComp = HitCharacter ? HitCharacter->GetStatsComponent() : nullptr;
+		DeferredAttack.Defense = FDamageCalculator::GetDefense(TargetStatsComp, DeferredAttack.AttackInfo.DamageType);
+		DeferredAttack.AttackIndex = CombatRandom.GetNextAttackIndex();
+		DeferredAttack.CritRoll = FDamageCalculator::RollCrit(CombatRandom.NextAttackStream());
+		DeferredDamageBatch.AddAttack(DeferredAttack.AttackInfo, DeferredAttack.Defense, DeferredAttack.CritRoll);
+	}
+	DeferredDamageBatch.Calculate();
+
+	// Deferred attacks were added one instigator at a time, so attacks of the same instigator are always next to each other
+	int32 AttackIndex = 0;
+	while (AttackIndex < NumAttacks)
+	{
+		AActor* HitInstigator = DeferredMeleeAttacks[AttackIndex].HitInstigator.Get();
+
+		int32 InstigatorEnd = AttackIndex + 1;
+		while (InstigatorEnd < NumAttacks && DeferredMeleeAttacks[InstigatorEnd].HitInstigator.Get() == HitInstigator)
+		{
+			InstigatorEnd++;
+		}
+
+		ICombatInterface* InstigatorCI = Cast<ICombatInterface>(HitInstigator);
+		if (!HitInstigator || !InstigatorCI)
+		{
+			AttackIndex = InstigatorEnd;
+			continue;
+		}
+
+		ScratchAttackResponses.Reset();
+		ScratchHitActors.Reset();
+
+		for (; AttackIndex < InstigatorEnd; AttackIndex++)
+		{
+			const FDeferredMeleeAttack& DeferredAttack = DeferredMeleeAttacks[AttackIndex];
+			AActor* HitTarget = DeferredAttack.HitTarget.Get();
+			ICombatInterface* TargetCI = Cast<ICombatInterface>(HitTarget);
+			// The target might have been destroyed while the trace was in flight
+			if (!TargetCI)
+			{
+				continue;
+			}
+
+			FCombatAttackRecord Record;
+			const bool bRecordAttack = CombatRecorder.IsRecording();
+			if (bRecordAttack)
+			{
+				BeginAttackRecord(Record, HitInstigator, HitTarget, DeferredAttack.AttackInfo, DeferredAttack.Defense, DeferredAttack.AttackIndex, DeferredAttack.CritRoll);
+			}
+
+			const FDamageOutcome DamageOutcome = DeferredDamageBatch.GetOutcome(AttackIndex);
+			FAttackResponse AttackResponse;
+			bool bAttackReceived = TargetCI->ReceiveAttack(
+				HitInstigator,
+				InstigatorCI,
+				DeferredAttack.AttackInfo,
+				DeferredAttack.HitResult,
+				DeferredAttack.bLineHitResultFound,
+				DeferredAttack.LineHitResult,
+				AttackResponse,
+				&DamageOutcome);
+
+			if (bAttackReceived)
 			{
-				AttackResponses.Add(*ResponsePtr);
+				if (bRecordAttack)
+				{
+					FinishAttackRecord(Record, HitTarget, AttackResponse);
+					CombatRecorder.RecordAttack(Record);
+				}
+
+				Statistics.NumAttacksReceived++;
+				ScratchHitActors.Add(HitTarget);
+				ScratchAttackResponses.Add(AttackResponse);
 			}
 		}
+
+		InstigatorCI->PostAttack(ScratchAttackResponses, ScratchHitActors);
 	}
 
-	InstigatorCI->PostAttack(AttackResponses, HitActors);
+	DeferredMeleeAttacks.RemoveAt(0, NumAttacks, false);
+	FirstDeferredSequence += (uint32)NumAttacks;
 }
 
-TSharedPtr<FAttackResponse> ACombatManager::ProcessAttack(AActor* HitInstigator, ICombatInterface* InstigatorCI, const TSharedPtr<FAttackInfo>& AttackInfoPtr, AActor* HitTarget, ICombatInterface* TargetCI, const FHitResult& HitResult)
+bool ACombatManager::ProcessAttack(
+	AActor* HitInstigator,
+	ICombatInterface* InstigatorCI,
+	const FAttackInfo& AttackInfo,
+	const FMeleeSwingTarget& SwingTarget,
+	const FDamageOutcome& DamageOutcome,
+	FAttackResponse& OutAttackResponse)
 {
+	AActor* HitTarget = SwingTarget.HitActor;
+	ICombatInterface* TargetCI = SwingTarget.TargetCI;
 	check(InstigatorCI && TargetCI);
 
-	TSharedPtr<FAttackResponse> DamageResponsePtr(nullptr);
-	if (!AttackInfoPtr.IsValid() || !InstigatorCI->IsEnemyOf(TargetCI))
+	FCombatAttackRecord Record;
+	const bool bRecordAttack = CombatRecorder.IsRecording();
+	if (bRecordAttack)
 	{
-		return DamageResponsePtr;
+		BeginAttackRecord(Record, HitInstigator, HitTarget, AttackInfo, SwingTarget.Defense, SwingTarget.AttackIndex, SwingTarget.CritRoll);
 	}
 
-	FHitResult LineHitResult;
-	bool bLineHitResultFound;
-	GetLineHitResult(HitInstigator, HitResult.GetComponent(), LineHitResult, bLineHitResultFound);
-
-	DamageResponsePtr = TargetCI->ReceiveAttack(HitInstigator, InstigatorCI, AttackInfoPtr, HitResult, bLineHitResultFound, LineHitResult);
+	const bool bAttackReceived = TargetCI->ReceiveAttack(
+		HitInstigator,
+		InstigatorCI,
+		AttackInfo,
+		*SwingTarget.HitResult,
+		SwingTarget.bLineHitResultFound,
+		SwingTarget.LineHitResult,
+		OutAttackResponse,
+		&DamageOutcome);
+	if (bAttackReceived)
+	{
+		if (bRecordAttack)
+		{
+			FinishAttackRecord(Record, HitTarget, OutAttackResponse);
+			CombatRecorder.RecordAttack(Record);
+		}
 
-	return DamageResponsePtr;
+		Statistics.NumAttacksReceived++;
+	}
+	return bAttackReceived;
 }
 
 void ACombatManager::GetLineHitResult(const AActor* HitInstigator, const AActor* HitTarget, FHitResult& OutHitResult, bool& bOutLineHitResultFound) const
@@ -116,9 +564,10 @@ void ACombatManager::GetLineHitResult(const AActor* HitInstigator, const AActor*
 	FVector LineEnd = HitTarget->GetActorLocation();
 	LineEnd.Z = LineStart.Z < LineEnd.Z ? LineStart.Z : LineEnd.Z;
 
-	TArray<FHitResult> LineHitResults;
-	GetWorld()->LineTraceMultiByChannel(LineHitResults, LineStart, LineEnd, COLLISION_COMBAT, QueryParams);
-	for (FHitResult& LineHitResult : LineHitResults)
+	ScratchLineHitResults.Reset();
+	Statistics.NumLineTraces++;
+	GetWorld()->LineTraceMultiByChannel(ScratchLineHitResults, LineStart, LineEnd, COLLISION_COMBAT, QueryParams);
+	for (FHitResult& LineHitResult : ScratchLineHitResults)
 	{
 		if (LineHitResult.GetActor() == HitTarget)
 		{
@@ -142,9 +591,10 @@ void ACombatManager::GetLineHitResult(const AActor* HitInstigator, const UPrimit
 	FVector LineEnd = HitComponent->GetComponentLocation();
 	LineEnd.Z = LineStart.Z < LineEnd.Z ? LineStart.Z : LineEnd.Z;
 
-	TArray<FHitResult> LineHitResults;
-	GetWorld()->LineTraceMultiByChannel(LineHitResults, LineStart, LineEnd, COLLISION_COMBAT, QueryParams);
-	for (FHitResult& LineHitResult : LineHitResults)
+	ScratchLineHitResults.Reset();
+	Statistics.NumLineTraces++;
+	GetWorld()->LineTraceMultiByChannel(ScratchLineHitResults, LineStart, LineEnd, COLLISION_COMBAT, QueryParams);
+	for (FHitResult& LineHitResult : ScratchLineHitResults)
 	{
 		if (LineHitResult.GetComponent() == HitComponent)
 		{
@@ -155,6 +605,197 @@ void ACombatManager::GetLineHitResult(const AActor* HitInstigator, const UPrimit
 	}
 }
 
+void ACombatManager::RegisterCharacter(AEODCharacterBase* Character)
+{
+	CharacterSpatialHash.AddCharacter(Character);
+}
+
+void ACombatManager::UnregisterCharacter(AEODCharacterBase* Character)
+{
+	CharacterSpatialHash.RemoveCharacter(Character);
+}
+
+const FCharacterSpatialHash& ACombatManager::GetCharacterSpatialHash()
+{
+	// The hash is rebuilt lazily so frames without any combat or aggro queries don't pay for it
+	CharacterSpatialHash.UpdateForFrame(GFrameCounter, GetWorld()->GetDeltaSeconds());
+	return CharacterSpatialHash;
+}
+
+const FAITargetSnapshot& ACombatManager::GetTargetSnapshot(const AEODCharacterBase* Target)
+{
+	// Snapshots are only valid for the frame they were captured in, so the keys never outlive their characters
+	if (TargetSnapshotsFrame != GFrameCounter)
+	{
+		TargetSnapshots.Reset();
+		TargetSnapshotsFrame = GFrameCounter;
+	}
+
+	FAITargetSnapshot* Snapshot = TargetSnapshots.Find(Target);
+	if (!Snapshot)
+	{
+		Snapshot = &TargetSnapshots.Add(Target);
+		Snapshot->Capture(Target);
+	}
+
+	return *Snapshot;
+}
+
+float ACombatManager::GetRewindTimestamp(const AActor* HitInstigator) const
+{
+	const float CurrentTime = GetWorld()->GetTimeSeconds();
+
+	const APawn* InstigatorPawn = Cast<APawn>(HitInstigator);
+	const APlayerController* PC = InstigatorPawn ? Cast<APlayerController>(InstigatorPawn->GetController()) : nullptr;
+	if (!PC || PC->IsLocalController() || !PC->PlayerState)
+	{
+		return CurrentTime;
+	}
+
+	// The client saw the other characters half a round trip late, and its attack took another half to reach the server
+	const float RewindTime = FMath::Min(PC->PlayerState->ExactPing * 0.001f, MaxRewindTime);
+	return CurrentTime - RewindTime;
+}
+
+bool ACombatManager::RewindCharacters(const AActor* HitInstigator, float Timestamp)
+{
+	SCOPE_CYCLE_COUNTER(STAT_EODRewindCharacters);
+
+	if (!HitInstigator || RewoundCharacters.Num() > 0)
+	{
+		return false;
+	}
+
+	GetCharacterSpatialHash().QuerySphere(HitInstigator->GetActorLocation(), RewindRadius, FCharacterQueryFilter(HitInstigator), ScratchRewindCandidates);
+	for (AEODCharacterBase* Character : ScratchRewindCandidates)
+	{
+		USkeletalMeshComponent* MeshComp = Character->GetMesh();
+		FTransform RewoundTransform;
+		if (!MeshComp || !Character->GetTransformHistory().Sample(Timestamp, RewoundTransform))
+		{
+			continue;
+		}
+
+		FRewoundCharacter RewoundCharacter;
+		RewoundCharacter.Character = Character;
+		RewoundCharacter.MeshRelativeTransform = MeshComp->GetRelativeTransform();
+
+		// Only the mesh is moved since that is what combat collision is tested against. Moving the actor would run movement and overlap logic
+		MeshComp->SetWorldTransform(RewoundTransform, false, nullptr, ETeleportType::TeleportPhysics);
+
+		// Broadphase queries made while rewound should see the rewound mesh. The actor didn't move, so the grid itself stays valid
+		RewoundCharacter.bSpatialHashBoundsExpanded = CharacterSpatialHash.ExpandEntryBounds(Character, MeshComp->Bounds.GetBox(), RewoundCharacter.SpatialHashBounds);
+		RewoundCharacters.Add(RewoundCharacter);
+	}
+
+	if (RewoundCharacters.Num() == 0)
+	{
+		return false;
+	}
+
+	RewoundTimestamp = Timestamp;
+	return true;
+}
+
+void ACombatManager::RestoreRewoundCharacters()
+{
+	for (const FRewoundCharacter& RewoundCharacter : RewoundCharacters)
+	{
+		AEODCharacterBase* Character = RewoundCharacter.Character.Get();
+		USkeletalMeshComponent* MeshComp = Character ? Character->GetMesh() : nullptr;
+		if (MeshComp)
+		{
+			MeshComp->SetRelativeTransform(RewoundCharacter.MeshRelativeTransform, false, nullptr, ETeleportType::TeleportPhysics);
+		}
+
+		if (RewoundCharacter.bSpatialHashBoundsExpanded)
+		{
+			CharacterSpatialHash.RestoreEntryBounds(Character, RewoundCharacter.SpatialHashBounds);
+		}
+	}
+
+	RewoundCharacters.Reset();
+}
+
+void ACombatManager::ResetStatistics()
+{
+	Statistics = FCombatManagerStatistics();
+}
+
+void ACombatManager::StartCombatRecording()
+{
+	CombatRecorder.Start(CombatRecordingBufferSize, CombatRandom.GetEncounterSeed());
+}
+
+void ACombatManager::StopCombatRecording()
+{
+	CombatRecorder.Stop();
+}
+
+bool ACombatManager::SaveCombatRecording(const FString& Filename) const
+{
+	return CombatRecorder.SaveToFile(Filename);
+}
+
+void ACombatManager::BeginAttackRecord(
+	FCombatAttackRecord& Record,
+	const AActor* HitInstigator,
+	const AActor* HitTarget,
+	const FAttackInfo& AttackInfo,
+	const FDamageDefense& Defense,
+	const uint32 AttackIndex,
+	const float CritRoll) const
+{
+	FMemory::Memzero(Record);
+	Record.Timestamp = GetWorld()->GetTimeSeconds();
+	Record.InstigatorId = HitInstigator->GetUniqueID();
+	Record.TargetId = HitTarget->GetUniqueID();
+	Record.AttackIndex = AttackIndex;
+	Record.CritRoll = CritRoll;
+	Record.CritRate = AttackInfo.CritRate;
+	Record.NormalDamage = AttackInfo.NormalDamage;
+	Record.CritDamage = AttackInfo.CritDamage;
+	Record.CrowdControlEffectDuration = AttackInfo.CrowdControlEffectDuration;
+	Record.Defense = Defense;
+	Record.DamageType = AttackInfo.DamageType;
+	Record.CrowdControlEffect = AttackInfo.CrowdControlEffect;
+	Record.bUndodgable = AttackInfo.bUndodgable;
+	Record.bUnblockable = AttackInfo.bUnblockable;
+
+	// The target state has to be captured before the attack, since the attack can kill the target or change its immunities
+	const AEODCharacterBase* HitCharacter = Cast<AEODCharacterBase>(HitTarget);
+	const UStatsComponentBase* StatsComp = HitCharacter ? HitCharacter->GetStatsComponent() : nullptr;
+	Record.TargetCCImmunities = StatsComp ? StatsComp->CCImmunities.GetImmunityMask() : 0;
+	// Same state that AEODCharacterBase::CanReceiveCCE passes to FCCImmunities::CanApplyCCE
+	Record.bTargetDead = HitCharacter ? HitCharacter->CharacterStateInfo.CharacterState == ECharacterState::Dead : false;
+}
+
+void ACombatManager::FinishAttackRecord(FCombatAttackRecord& Record, const AActor* HitTarget, const FAttackResponse& AttackResponse) const
+{
+	Record.bCritHit = AttackResponse.bCritHit;
+	Record.DamageResult = AttackResponse.DamageResult;
+	Record.ReceivedCrowdControlEffect = AttackResponse.CrowdControlEffect;
+	Record.ActualDamage = AttackResponse.ActualDamage;
+
+	const AEODCharacterBase* HitCharacter = Cast<AEODCharacterBase>(HitTarget);
+	Record.BCAngle = HitCharacter ? HitCharacter->GetLastReceivedHitInfo().BCAngle : 0.f;
+}
+
+uint32 ACombatManager::GetCombatBuffersAllocatedSize() const
+{
+	return PendingMeleeRequests.GetAllocatedSize() +
+		PendingHitResults.GetAllocatedSize() +
+		ScratchAttackResponses.GetAllocatedSize() +
+		ScratchHitActors.GetAllocatedSize() +
+		ScratchSwingTargets.GetAllocatedSize() +
+		ScratchLineHitResults.GetAllocatedSize() +
+		DeferredMeleeAttacks.GetAllocatedSize() +
+		DeferredDamageBatch.GetAllocatedSize() +
+		SwingDamageBatch.GetAllocatedSize() +
+		RewoundCharacters.GetAllocatedSize() +
+		ScratchRewindCandidates.GetAllocatedSize();
+}
+
 bool ACombatManager::AreEnemies(AEODCharacterBase* CharOne, AEODCharacterBase* CharTwo)
 {
 	ICombatInterface* CIOne = Cast<ICombatInterface>(CharOne);
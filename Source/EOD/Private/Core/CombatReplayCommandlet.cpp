@@ -0,0 +1,147 @@
+// Copyright 2018 Moikkai Games. All Rights Reserved.
+
+#include "CombatReplayCommandlet.h"
+#include "CombatRecorder.h"
+#include "CombatRandom.h"
+#include "DamageCalculator.h"
+#include "StatsComponentBase.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogCombatReplay, Log, All);
+
+UCombatReplayCommandlet::UCombatReplayCommandlet(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
+{
+	IsClient = false;
+	IsServer = true;
+	IsEditor = false;
+	LogToConsole = true;
+}
+
+int32 UCombatReplayCommandlet::Main(const FString& Params)
+{
+	FString RecordingPath;
+	int32 NumIterations = 1;
+
+	FParse::Value(*Params, TEXT("Recording="), RecordingPath);
+	FParse::Value(*Params, TEXT("Iterations="), NumIterations);
+	NumIterations = FMath::Max(NumIterations, 1);
+
+	if (RecordingPath.IsEmpty())
+	{
+		UE_LOG(LogCombatReplay, Error, TEXT("Usage: -run=CombatReplay -Recording=<path to recording> [-Iterations=1]"));
+		return 1;
+	}
+
+	FCombatRecording Recording;
+	if (!FCombatRecorder::LoadFromFile(RecordingPath, Recording))
+	{
+		UE_LOG(LogCombatReplay, Error, TEXT("Failed to load combat recording %s"), *RecordingPath);
+		return 1;
+	}
+
+	UE_LOG(LogCombatReplay, Display, TEXT("Replaying %d melee swings and %d attacks of encounter %d, %d iterations"),
+		Recording.HitRequests.Num(), Recording.Attacks.Num(), Recording.EncounterSeed, NumIterations);
+
+	// Whether an attack is dodged depends on the state of its target, which isn't recorded
+	TArray<const FCombatAttackRecord*> ReplayedAttacks;
+	for (const FCombatAttackRecord& Record : Recording.Attacks)
+	{
+		if (Record.DamageResult != EDamageResult::Dodged)
+		{
+			ReplayedAttacks.Add(&Record);
+		}
+	}
+
+	int32 NumRollMismatches = 0;
+	int32 NumCritMismatches = 0;
+	int32 NumDamageMismatches = 0;
+	int32 NumCCEMismatches = 0;
+	int32 NumBatchMismatches = 0;
+
+	FDamageBatch DamageBatch;
+	const double StartTime = FPlatformTime::Seconds();
+
+	for (int32 Iteration = 0; Iteration < NumIterations; Iteration++)
+	{
+		DamageBatch.Reset();
+		for (const FCombatAttackRecord* Record : ReplayedAttacks)
+		{
+			DamageBatch.AddAttack(Record->GetAttackInfo(), Record->Defense, Record->CritRoll);
+		}
+		DamageBatch.Calculate();
+
+		// Results are identical on every iteration, so only the first one is compared
+		if (Iteration > 0)
+		{
+			continue;
+		}
+
+		for (int32 Index = 0; Index < ReplayedAttacks.Num(); Index++)
+		{
+			const FCombatAttackRecord& Record = *ReplayedAttacks[Index];
+			const bool bAttackBlocked = Record.DamageResult == EDamageResult::Blocked;
+			const FDamageOutcome Outcome = DamageBatch.GetOutcome(Index);
+
+			// The batch has to stay bit identical to the scalar calculation it replaced
+			const FAttackInfo AttackInfo = Record.GetAttackInfo();
+			const FDamageOutcome ScalarOutcome = FDamageCalculator::CalculateDamage(AttackInfo, Record.Defense, FDamageCalculator::IsCritRoll(AttackInfo.CritRate, Record.CritRoll));
+			if (ScalarOutcome.bCritHit != Outcome.bCritHit || ScalarOutcome.Damage != Outcome.Damage || ScalarOutcome.BlockedDamage != Outcome.BlockedDamage)
+			{
+				NumBatchMismatches++;
+				UE_LOG(LogCombatReplay, Verbose, TEXT("Attack %u: batch damage %f (%f blocked), scalar damage %f (%f blocked)"),
+					Record.AttackIndex, Outcome.Damage, Outcome.BlockedDamage, ScalarOutcome.Damage, ScalarOutcome.BlockedDamage);
+			}
+
+			const float CritRoll = FDamageCalculator::RollCrit(FCombatRandom::GetAttackStream(Recording.EncounterSeed, Record.AttackIndex));
+			if (CritRoll != Record.CritRoll)
+			{
+				NumRollMismatches++;
+			}
+
+			if (Outcome.bCritHit != (bool)Record.bCritHit)
+			{
+				NumCritMismatches++;
+			}
+
+			// Received damage is truncated to an integer
+			const int32 ActualDamage = (int32)Outcome.GetDamage(bAttackBlocked);
+			if (ActualDamage != Record.ActualDamage)
+			{
+				NumDamageMismatches++;
+				UE_LOG(LogCombatReplay, Verbose, TEXT("Attack %u: replayed damage %d, recorded damage %d"), Record.AttackIndex, ActualDamage, Record.ActualDamage);
+			}
+
+			// A flinch is received both when a flinch is applied and when no crowd control effect is applied, so flinches can't be compared
+			if (Record.CrowdControlEffect != ECrowdControlEffect::Flinch)
+			{
+				const bool bCCEApplied = Record.ReceivedCrowdControlEffect == Record.CrowdControlEffect;
+				const bool bCanApplyCCE = FCCImmunities::CanApplyCCE(
+					Record.TargetCCImmunities,
+					Record.CrowdControlEffect,
+					Record.DamageResult == EDamageResult::Blocked,
+					Record.bTargetDead);
+				if (bCanApplyCCE != bCCEApplied)
+				{
+					NumCCEMismatches++;
+				}
+			}
+		}
+	}
+
+	const double WallSeconds = FPlatformTime::Seconds() - StartTime;
+	const double NumReplayedAttacks = (double)ReplayedAttacks.Num() * NumIterations;
+	const float RecordedSeconds = Recording.Attacks.Num() > 1 ? Recording.Attacks.Last().Timestamp - Recording.Attacks[0].Timestamp : 0.f;
+
+	UE_LOG(LogCombatReplay, Display, TEXT("Replayed %.0f attacks in %.3f ms (%.2f attacks per second). Recording spans %.2f seconds"),
+		NumReplayedAttacks, WallSeconds * 1000.0, WallSeconds > 0.0 ? NumReplayedAttacks / WallSeconds : 0.0, RecordedSeconds);
+	UE_LOG(LogCombatReplay, Display, TEXT("Mismatches: %d crit rolls, %d crits, %d damage, %d crowd control effects, %d batch vs scalar"),
+		NumRollMismatches, NumCritMismatches, NumDamageMismatches, NumCCEMismatches, NumBatchMismatches);
+
+	// Crowd control effects also depend on character state that isn't recorded (e.g. already being knocked down), so those mismatches are only reported
+	if (NumRollMismatches > 0 || NumCritMismatches > 0 || NumDamageMismatches > 0 || NumBatchMismatches > 0)
+	{
+		UE_LOG(LogCombatReplay, Error, TEXT("Replayed combat differs from the recording"));
+		return 2;
+	}
+
+	return 0;
+}
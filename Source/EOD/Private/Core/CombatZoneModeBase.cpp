@@ -24,6 +24,10 @@ void ACombatZoneModeBase::InitGame(const FString& MapName, const FString& Option
 			// We don't want status effects manager or combat manager to be saved into map
 			SpawnInfo.ObjectFlags |= RF_Transient;
 			CombatManager = World->SpawnActor<ACombatManager>(CombatManagerClass, SpawnInfo);
+			if (CombatManager)
+			{
+				CombatManager->GetCombatRandom().Initialize(GetCombatRandomSeed());
+			}
 		}
 	}
 }
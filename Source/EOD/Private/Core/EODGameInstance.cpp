@@ -6,6 +6,7 @@
 #include "PlayerSaveGame.h"
 #include "EODGlobalNames.h"
 #include "DamageNumberWidget.h"
+#include "GameplaySkillBase.h"
 
 #include "MoviePlayer.h"
 #include "Blueprint/UserWidget.h"
@@ -36,6 +37,51 @@ void UEODGameInstance::Init()
 
 }
 
+const TArray<UGameplaySkillBase*>& UEODGameInstance::GetSharedSkills(UDataTable* SkillsDataTable)
+{
+	check(SkillsDataTable);
+
+	FSharedSkillSet* SkillSet = SharedSkills.Find(SkillsDataTable);
+	if (SkillSet)
+	{
+		return SkillSet->Skills;
+	}
+
+	SkillSet = &SharedSkills.Add(SkillsDataTable);
+
+	FString ContextString = FString("UEODGameInstance::GetSharedSkills()");
+	TArray<FName> Keys = SkillsDataTable->GetRowNames();
+	check(Keys.Num() <= MAX_uint8);
+
+	SkillSet->Skills.SetNumZeroed(Keys.Num() + 1);
+	uint8 SkillIndex = 1;
+	for (FName Key : Keys)
+	{
+		FGameplaySkillTableRow* Row = SkillsDataTable->FindRow<FGameplaySkillTableRow>(Key, ContextString);
+		check(Row);
+
+		// Different data tables may have rows with the same name
+		FName SkillName = MakeUniqueObjectName(this, Row->SkillClass, Key);
+		UGameplaySkillBase* GameplaySkill = NewObject<UGameplaySkillBase>(this, Row->SkillClass, SkillName, RF_Transient);
+		check(GameplaySkill);
+		GameplaySkill->SetSkillIndex(SkillIndex);
+
+		if (GameplaySkill->GetSkillGroup() == NAME_None)
+		{
+			GameplaySkill->SetSkillGroup(Key);
+		}
+		else
+		{
+			check(GameplaySkill->GetSkillGroup() == Key);
+		}
+
+		SkillSet->Skills[SkillIndex] = GameplaySkill;
+		SkillIndex++;
+	}
+
+	return SkillSet->Skills;
+}
+
 void UEODGameInstance::StartNewCampaign()
 {
 	UGameplayStatics::OpenLevel(this, StartupMapName);
@@ -135,6 +181,9 @@ void UEODGameInstance::LoadSaveGame()
 
 void UEODGameInstance::OnPreLoadMap(const FString& MapName)
 {
+	// Shared skills hold hard references to their animations, which the next map may not need
+	SharedSkills.Empty();
+
 	IGameMoviePlayer* MoviePlayer = GetMoviePlayer();
 
 	if (!MoviePlayer || MoviePlayer->IsStartupMoviePlaying() || IsRunningDedicatedServer())
@@ -3,6 +3,7 @@
 #include "EODGameModeBase.h"
 #include "EODSaveGame.h"
 #include "GameSingleton.h"
+#include "RegenerationManager.h"
 // #include "StatusEffectsManager.h"
 
 #include "EODPlayerController.h"
@@ -13,15 +14,33 @@
 
 AEODGameModeBase::AEODGameModeBase(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
 {
+	RegenerationManagerClass = ARegenerationManager::StaticClass();
+	CombatRandomSeed = 0;
 }
 
 void AEODGameModeBase::InitGame(const FString& MapName, const FString& Options, FString& ErrorMessage)
 {
 	Super::InitGame(MapName, Options, ErrorMessage);
 
+	CombatRandomSeed = UGameplayStatics::GetIntOption(Options, TEXT("CombatSeed"), CombatRandomSeed);
+	if (CombatRandomSeed == 0)
+	{
+		CombatRandomSeed = FMath::RandRange(1, MAX_int32);
+	}
+	UE_LOG(LogGameMode, Log, TEXT("Combat random seed: %d"), CombatRandomSeed);
+
 	UWorld* World = GetWorld();
 	if (World)
 	{
+		if (RegenerationManagerClass.Get())
+		{
+			FActorSpawnParameters SpawnInfo;
+			SpawnInfo.Owner = this;
+			// We don't want regeneration manager to be saved into map
+			SpawnInfo.ObjectFlags |= RF_Transient;
+			RegenerationManager = World->SpawnActor<ARegenerationManager>(RegenerationManagerClass, SpawnInfo);
+		}
+
 		/*
 		if (StatusEffectsManagerClass.Get())
 		{
@@ -62,6 +81,11 @@ UClass* AEODGameModeBase::GetDefaultPawnClassForController_Implementation(AContr
 	return Super::GetDefaultPawnClassForController_Implementation(InController);
 }
 
+ARegenerationManager* AEODGameModeBase::BP_GetRegenerationManager() const
+{
+	return GetRegenerationManager();
+}
+
 /*
 AStatusEffectsManager* AEODGameModeBase::BP_GetStatusEffectsManager() const
 {
@@ -0,0 +1,189 @@
+// Copyright 2018 Moikkai Games. All Rights Reserved.
+
+#include "RegenerationManager.h"
+#include "EODCharacterBase.h"
+#include "StatsComponentBase.h"
+
+#include "Async/ParallelFor.h"
+
+DECLARE_CYCLE_STAT(TEXT("EOD Regeneration"), STAT_EODRegeneration, STATGROUP_EOD);
+
+ARegenerationManager::ARegenerationManager(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
+{
+	// The regeneration manager only ticks while there are regenerating stats
+	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.bStartWithTickEnabled = false;
+
+	SetReplicates(false);
+	SetReplicateMovement(false);
+
+	RegenerationPassInterval = 0.1f;
+	bUseParallelPass = true;
+	MinEntriesForParallelPass = 512;
+	NumActiveEntries = 0;
+	bHasStoppedEntries = false;
+}
+
+void ARegenerationManager::BeginPlay()
+{
+	Super::BeginPlay();
+
+	// The actual time elapsed between ticks is passed to Tick, so the regeneration rates don't depend on this interval
+	SetActorTickInterval(RegenerationPassInterval);
+}
+
+void ARegenerationManager::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	SCOPE_CYCLE_COUNTER(STAT_EODRegeneration);
+
+	CountPendingTicks(DeltaTime);
+	ApplyPendingTicks();
+	RemoveStoppedEntries();
+
+	if (NumActiveEntries == 0)
+	{
+		SetActorTickEnabled(false);
+	}
+}
+
+void ARegenerationManager::StartRegeneration(UStatsComponentBase* StatsComp, ERegeneratingStat Stat, float TickInterval)
+{
+	if (!StatsComp || TickInterval <= 0.f)
+	{
+		return;
+	}
+
+	const int32 Index = FindEntry(StatsComp, Stat);
+	if (Index != INDEX_NONE)
+	{
+		Entries[Index].TickInterval = TickInterval;
+		return;
+	}
+
+	FRegenerationEntry Entry;
+	Entry.StatsComp = StatsComp;
+	Entry.Stat = Stat;
+	Entry.TickInterval = TickInterval;
+	Entry.TimeSinceLastTick = 0.f;
+	Entry.PendingTicks = 0;
+	Entry.bStopped = false;
+	EntryIndices.Add(MakeKey(Entry.StatsComp, Stat), Entries.Add(Entry));
+	NumActiveEntries++;
+
+	if (!IsActorTickEnabled())
+	{
+		SetActorTickEnabled(true);
+	}
+}
+
+void ARegenerationManager::StopRegeneration(UStatsComponentBase* StatsComp, ERegeneratingStat Stat)
+{
+	const int32 Index = FindEntry(StatsComp, Stat);
+	if (Index != INDEX_NONE)
+	{
+		StopEntry(Index);
+	}
+}
+
+int32 ARegenerationManager::FindEntry(const UStatsComponentBase* StatsComp, ERegeneratingStat Stat) const
+{
+	const int32* Index = EntryIndices.Find(MakeKey(StatsComp, Stat));
+	return Index ? *Index : INDEX_NONE;
+}
+
+void ARegenerationManager::StopEntry(int32 Index)
+{
+	FRegenerationEntry& Entry = Entries[Index];
+	EntryIndices.Remove(MakeKey(Entry.StatsComp, Entry.Stat));
+	Entry.bStopped = true;
+	NumActiveEntries--;
+	bHasStoppedEntries = true;
+}
+
+void ARegenerationManager::CountPendingTicks(float DeltaTime)
+{
+	auto CountEntryTicks = [this, DeltaTime](int32 Index)
+	{
+		FRegenerationEntry& Entry = Entries[Index];
+		Entry.TimeSinceLastTick += DeltaTime;
+		Entry.PendingTicks = FMath::FloorToInt(Entry.TimeSinceLastTick / Entry.TickInterval);
+		Entry.TimeSinceLastTick -= Entry.PendingTicks * Entry.TickInterval;
+	};
+
+	// Counting only touches the entries themselves, so it can be split across worker threads
+	if (bUseParallelPass && Entries.Num() >= MinEntriesForParallelPass)
+	{
+		ParallelFor(Entries.Num(), CountEntryTicks);
+	}
+	else
+	{
+		for (int32 i = 0; i < Entries.Num(); i++)
+		{
+			CountEntryTicks(i);
+		}
+	}
+}
+
+void ARegenerationManager::ApplyPendingTicks()
+{
+	// Stats broadcast their changes to gameplay code and UI, so they are always modified on game thread.
+	// Entries started while applying are appended past NumEntries and will be updated on the next pass.
+	const int32 NumEntries = Entries.Num();
+	for (int32 i = 0; i < NumEntries; i++)
+	{
+		// Regenerating a stat can stop it, so re-check the entry on every update
+		for (int32 TickIndex = 0; TickIndex < Entries[i].PendingTicks && !Entries[i].bStopped; TickIndex++)
+		{
+			UStatsComponentBase* StatsComp = Entries[i].StatsComp.Get();
+			if (!StatsComp)
+			{
+				// The stats component was destroyed without stopping its regeneration
+				StopEntry(i);
+				break;
+			}
+
+			switch (Entries[i].Stat)
+			{
+			case ERegeneratingStat::Health:
+				StatsComp->RegenerateHealth();
+				break;
+			case ERegeneratingStat::Mana:
+				StatsComp->RegenerateMana();
+				break;
+			case ERegeneratingStat::Stamina:
+				StatsComp->RegenerateStamina();
+				break;
+			default:
+				break;
+			}
+		}
+	}
+}
+
+void ARegenerationManager::RemoveStoppedEntries()
+{
+	if (!bHasStoppedEntries)
+	{
+		return;
+	}
+
+	// Going backwards, the last entry has always been kept, so it is the only one whose index changes on each swap
+	for (int32 i = Entries.Num() - 1; i >= 0; i--)
+	{
+		if (!Entries[i].bStopped)
+		{
+			continue;
+		}
+
+		const int32 LastIndex = Entries.Num() - 1;
+		if (i != LastIndex)
+		{
+			const FRegenerationEntry& LastEntry = Entries[LastIndex];
+			EntryIndices.FindChecked(MakeKey(LastEntry.StatsComp, LastEntry.Stat)) = i;
+		}
+		Entries.RemoveAtSwap(i, 1, false);
+	}
+	bHasStoppedEntries = false;
+}
@@ -5,6 +5,7 @@
 #include "EODCharacterBase.h"
 #include "EODCharacterMovementComponent.h"
 #include "AILibrary.h"
+#include "AISkillsComponent.h"
 
 #include "AIController.h"
 #include "BehaviorTree/BlackboardComponent.h"
@@ -13,9 +14,9 @@ UAIInstantMeleeSkill::UAIInstantMeleeSkill(const FObjectInitializer& ObjectIniti
 {
 }
 
-void UAIInstantMeleeSkill::TriggerSkill()
+void UAIInstantMeleeSkill::TriggerSkillFor(UAISkillsComponent* SkillsComp)
 {
-	AEODCharacterBase* Instigator = SkillInstigator.Get();
+	AEODCharacterBase* Instigator = SkillsComp ? SkillsComp->GetCharacterOwner() : nullptr;
 	if (!Instigator)
 	{
 		return;
@@ -56,7 +57,7 @@ void UAIInstantMeleeSkill::TriggerSkill()
 
 	if (SkillMontage)
 	{
-		SkillDuration = Instigator->PlayAnimMontage(SkillMontage, 1.f, AnimationStartSectionName);
+		float SkillDuration = Instigator->PlayAnimMontage(SkillMontage, 1.f, AnimationStartSectionName);
 		float ActualSkillDuration;
 
 		if (SkillMontage->BlendOutTriggerTime >= 0.f)
@@ -70,9 +71,10 @@ void UAIInstantMeleeSkill::TriggerSkill()
 
 		UWorld* World = Instigator->GetWorld();
 		check(World);
+		// The timer is bound to the skills component since this skill is shared with other AI characters
 		FTimerDelegate TimerDelegate;
-		TimerDelegate.BindUObject(this, &UAIInstantMeleeSkill::FinishSkill);
-		World->GetTimerManager().SetTimer(SkillTimerHandle, TimerDelegate, ActualSkillDuration, false);
+		TimerDelegate.BindUObject(SkillsComp, &UAISkillsComponent::FinishActiveSkill, SkillIndex);
+		World->GetTimerManager().SetTimer(SkillsComp->GetSkillTimerHandle(), TimerDelegate, ActualSkillDuration, false);
 
 		Instigator->OnSkillActivated(SkillIndex, SkillGroup, this);
 	}
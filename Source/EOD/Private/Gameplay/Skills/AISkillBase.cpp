@@ -5,7 +5,9 @@
 #include "AIStatsComponent.h"
 #include "AICharacterBase.h"
 #include "EODAIControllerBase.h"
-#include "GameplaySkillsComponent.h"
+#include "AISkillsComponent.h"
+
+#include "TimerManager.h"
 
 UAISkillBase::UAISkillBase(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
 {
@@ -14,9 +16,41 @@ UAISkillBase::UAISkillBase(const FObjectInitializer& ObjectInitializer) : Super(
 	CamShakeType						= ECameraShakeType::Weak;
 }
 
+bool UAISkillBase::CanReleaseSkill() const
+{
+	return false;
+}
+
 bool UAISkillBase::CanTriggerSkill() const
 {
-	AEODCharacterBase* Instigator = SkillInstigator.Get();
+	ensureMsgf(false, TEXT("AI skill %s is shared between AI characters, use CanTriggerSkillFor() instead"), *GetSkillGroup().ToString());
+	return false;
+}
+
+void UAISkillBase::TriggerSkill()
+{
+	ensureMsgf(false, TEXT("AI skill %s is shared between AI characters, use TriggerSkillFor() instead"), *GetSkillGroup().ToString());
+}
+
+void UAISkillBase::CancelSkill()
+{
+	ensureMsgf(false, TEXT("AI skill %s is shared between AI characters, use CancelSkillFor() instead"), *GetSkillGroup().ToString());
+}
+
+void UAISkillBase::FinishSkill()
+{
+	ensureMsgf(false, TEXT("AI skill %s is shared between AI characters, use FinishSkillFor() instead"), *GetSkillGroup().ToString());
+}
+
+bool UAISkillBase::GetAttackInfo(int32 CollisionIndex, FAttackInfo& OutAttackInfo)
+{
+	ensureMsgf(false, TEXT("AI skill %s is shared between AI characters, use GetAttackInfoFor() instead"), *GetSkillGroup().ToString());
+	return false;
+}
+
+bool UAISkillBase::CanTriggerSkillFor(UAISkillsComponent* SkillsComp) const
+{
+	AEODCharacterBase* Instigator = SkillsComp ? SkillsComp->GetCharacterOwner() : nullptr;
 
 	if (Instigator)
 	{
@@ -27,36 +61,42 @@ bool UAISkillBase::CanTriggerSkill() const
 	return false;
 }
 
-void UAISkillBase::TriggerSkill()
+void UAISkillBase::TriggerSkillFor(UAISkillsComponent* SkillsComp)
 {
 }
 
-bool UAISkillBase::CanReleaseSkill() const
+void UAISkillBase::CancelSkillFor(UAISkillsComponent* SkillsComp)
 {
-	return false;
+	check(SkillsComp);
+
+	UWorld* World = SkillsComp->GetWorld();
+	if (World)
+	{
+		World->GetTimerManager().ClearTimer(SkillsComp->GetSkillTimerHandle());
+	}
+
+	SkillsComp->OnSkillCancelled(SkillIndex, SkillGroup, this);
 }
 
-void UAISkillBase::FinishSkill()
+void UAISkillBase::FinishSkillFor(UAISkillsComponent* SkillsComp)
 {
-	AEODCharacterBase* Instigator = SkillInstigator.Get();
+	check(SkillsComp);
+
+	AEODCharacterBase* Instigator = SkillsComp->GetCharacterOwner();
 	if (Instigator)
 	{
 		Instigator->ResetState();
 	}
 
-	UGameplaySkillsComponent* SkillsComp = InstigatorSkillComponent.Get();
-	if (SkillsComp)
-	{
-		SkillsComp->OnSkillFinished(SkillIndex, SkillGroup, this);
-	}
+	SkillsComp->OnSkillFinished(SkillIndex, SkillGroup, this);
 }
 
-TSharedPtr<FAttackInfo> UAISkillBase::GetAttackInfoPtr(int32 CollisionIndex)
+bool UAISkillBase::GetAttackInfoFor(UAISkillsComponent* SkillsComp, int32 CollisionIndex, FAttackInfo& OutAttackInfo) const
 {
-	AEODCharacterBase* Instigator = SkillInstigator.Get();
-	if (Instigator->Role < ROLE_Authority)
+	AEODCharacterBase* Instigator = SkillsComp ? SkillsComp->GetCharacterOwner() : nullptr;
+	if (!Instigator || Instigator->Role < ROLE_Authority)
 	{
-		return TSharedPtr<FAttackInfo>();
+		return false;
 	}
 
 	AEODAIControllerBase* AIC = Instigator ? Cast<AEODAIControllerBase>(Instigator->Controller) : nullptr;
@@ -73,18 +113,16 @@ TSharedPtr<FAttackInfo> UAISkillBase::GetAttackInfoPtr(int32 CollisionIndex)
 		(NormalDamage * UCombatLibrary::MagickalCritMultiplier + StatsComp->MagickalCritBonus.GetValue()) :
 		(NormalDamage * UCombatLibrary::PhysicalCritMultiplier + StatsComp->PhysicalCritBonus.GetValue());
 
-	TSharedPtr<FAttackInfo> AttackInfoPtr =
-		MakeShareable(new FAttackInfo(
-			SkillInfo.bUndodgable,
-			SkillInfo.bUnblockable,
-			CritRate,
-			NormalDamage,
-			CritDamage,
-			DamageType,
-			SkillInfo.CCEffectInfo.CCEffect,
-			SkillInfo.CCEffectInfo.CCDuration,
-			CamShakeType
-		));
-
-	return AttackInfoPtr;
+	OutAttackInfo = FAttackInfo(
+		SkillInfo.bUndodgable,
+		SkillInfo.bUnblockable,
+		CritRate,
+		NormalDamage,
+		CritDamage,
+		DamageType,
+		SkillInfo.CCEffectInfo.CCEffect,
+		SkillInfo.CCEffectInfo.CCDuration,
+		CamShakeType);
+
+	return true;
 }
@@ -16,7 +16,6 @@ UActiveSkillBase::UActiveSkillBase(const FObjectInitializer& ObjectInitializer)
 {
 	SupersedingSkillGroup			= NAME_None;
 	AnimationStartSectionName		= FName("Default");
-	CooldownRemaining				= 0.f;
 	FailSafeDuration				= 0.5f;
 	CamShakeType					= ECameraShakeType::Weak;
 }
@@ -287,12 +286,12 @@ void UActiveSkillBase::LoseCCImmunities()
 	}
 }
 
-TSharedPtr<FAttackInfo> UActiveSkillBase::GetAttackInfoPtr(int32 CollisionIndex)
+bool UActiveSkillBase::GetAttackInfo(int32 CollisionIndex, FAttackInfo& OutAttackInfo)
 {
 	AEODCharacterBase* Instigator = SkillInstigator.Get();
-	if (Instigator->Role < ROLE_Authority)
+	if (!Instigator || Instigator->Role < ROLE_Authority)
 	{
-		return TSharedPtr<FAttackInfo>();
+		return false;
 	}
 
 	AEODPlayerController* PC = Instigator ? Cast<AEODPlayerController>(Instigator->Controller) : nullptr;
@@ -310,20 +309,18 @@ TSharedPtr<FAttackInfo> UActiveSkillBase::GetAttackInfoPtr(int32 CollisionIndex)
 		(NormalDamage * UCombatLibrary::MagickalCritMultiplier + StatsComp->MagickalCritBonus.GetValue()) :
 		(NormalDamage * UCombatLibrary::PhysicalCritMultiplier + StatsComp->PhysicalCritBonus.GetValue());
 
-	TSharedPtr<FAttackInfo> AttackInfoPtr =
-		MakeShareable(new FAttackInfo(
-			SkillInfo.bUndodgable,
-			SkillInfo.bUnblockable,
-			CritRate,
-			NormalDamage,
-			CritDamage,
-			DamageType,
-			SkillInfo.CrowdControlEffect,
-			SkillInfo.CrowdControlEffectDuration,
-			CamShakeType
-		));
-
-	return AttackInfoPtr;
+	OutAttackInfo = FAttackInfo(
+		SkillInfo.bUndodgable,
+		SkillInfo.bUnblockable,
+		CritRate,
+		NormalDamage,
+		CritDamage,
+		DamageType,
+		SkillInfo.CrowdControlEffect,
+		SkillInfo.CrowdControlEffectDuration,
+		CamShakeType);
+
+	return true;
 }
 
 void UActiveSkillBase::LoadFemaleAnimations()
@@ -337,10 +334,15 @@ void UActiveSkillBase::LoadFemaleAnimations()
 		WeaponToFemaleAnimationMontageMap.GetKeys(Keys);
 		for (EWeaponType Key : Keys)
 		{
-			FSoftObjectPath ObjectPath = WeaponToFemaleAnimationMontageMap[Key].ToSoftObjectPath();
-			if (ObjectPath.IsValid())
+			const TSoftObjectPtr<UAnimMontage>& SoftAnimation = WeaponToFemaleAnimationMontageMap[Key];
+			if (SoftAnimation.IsValid())
 			{
-				AnimationsToLoad.AddUnique(ObjectPath);
+				// Already loaded by another character using this skill
+				SkillAnimations.Add(Key, SoftAnimation.Get());
+			}
+			else if (SoftAnimation.ToSoftObjectPath().IsValid())
+			{
+				AnimationsToLoad.AddUnique(SoftAnimation.ToSoftObjectPath());
 			}
 		}
 
@@ -364,10 +366,15 @@ void UActiveSkillBase::LoadMaleAnimations()
 		WeaponToMaleAnimationMontageMap.GetKeys(Keys);
 		for (EWeaponType Key : Keys)
 		{
-			FSoftObjectPath ObjectPath = WeaponToMaleAnimationMontageMap[Key].ToSoftObjectPath();
-			if (ObjectPath.IsValid())
+			const TSoftObjectPtr<UAnimMontage>& SoftAnimation = WeaponToMaleAnimationMontageMap[Key];
+			if (SoftAnimation.IsValid())
+			{
+				// Already loaded by another character using this skill
+				SkillAnimations.Add(Key, SoftAnimation.Get());
+			}
+			else if (SoftAnimation.ToSoftObjectPath().IsValid())
 			{
-				AnimationsToLoad.AddUnique(ObjectPath);
+				AnimationsToLoad.AddUnique(SoftAnimation.ToSoftObjectPath());
 			}
 		}
 
@@ -410,50 +417,16 @@ void UActiveSkillBase::OnMaleAnimationsLoaded()
 
 void UActiveSkillBase::StartCooldown()
 {
-	AEODCharacterBase* Instigator = SkillInstigator.Get();
-	check(Instigator);
-	UWorld* World = Instigator->GetWorld();
-	check(World);
-
-	const FActiveSkillLevelUpInfo CurrentLevelUpInfo = GetCurrentSkillLevelupInfo();
-	World->GetTimerManager().SetTimer(CooldownTimerHandle, this, &UActiveSkillBase::UpdateCooldown, 1.f, true);
-	CooldownRemaining = CurrentLevelUpInfo.Cooldown;
-
 	UGameplaySkillsComponent* SkillComp = InstigatorSkillComponent.Get();
 	check(SkillComp);
-	SkillComp->UpdateSkillCooldown(SkillGroup, CooldownRemaining);
-}
 
-void UActiveSkillBase::FinishCooldown()
-{
-	AEODCharacterBase* Instigator = SkillInstigator.Get();
-	check(Instigator);
-	UWorld* World = Instigator->GetWorld();
-	check(World);
-
-	World->GetTimerManager().ClearTimer(CooldownTimerHandle);
-
-	UGameplaySkillsComponent* SkillComp = InstigatorSkillComponent.Get();
-	check(SkillComp);
-	CooldownRemaining = 0.f;
-	SkillComp->UpdateSkillCooldown(SkillGroup, CooldownRemaining);
+	const FActiveSkillLevelUpInfo CurrentLevelUpInfo = GetCurrentSkillLevelupInfo();
+	SkillComp->StartSkillCooldown(SkillIndex, CurrentLevelUpInfo.Cooldown);
 }
 
 void UActiveSkillBase::CancelCooldown()
 {
-	FinishCooldown();
-}
-
-void UActiveSkillBase::UpdateCooldown()
-{
-	CooldownRemaining--;
-
-	if (CooldownRemaining <= 0.f)
-	{
-		FinishCooldown();
-	}
-
 	UGameplaySkillsComponent* SkillComp = InstigatorSkillComponent.Get();
 	check(SkillComp);
-	SkillComp->UpdateSkillCooldown(SkillGroup, CooldownRemaining);
+	SkillComp->CancelSkillCooldown(SkillIndex);
 }
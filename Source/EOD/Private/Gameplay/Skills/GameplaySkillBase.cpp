@@ -58,9 +58,9 @@ void UGameplaySkillBase::FinishSkill()
 	}
 }
 
-TSharedPtr<FAttackInfo> UGameplaySkillBase::GetAttackInfoPtr(int32 CollisionIndex)
+bool UGameplaySkillBase::GetAttackInfo(int32 CollisionIndex, FAttackInfo& OutAttackInfo)
 {
-	return TSharedPtr<FAttackInfo>(nullptr);
+	return false;
 }
 
 bool UGameplaySkillBase::CanCancelSkill() const
@@ -121,19 +121,23 @@ void UPlayerSkillBase::OnDeactivatedAsChainSkill()
 	}
 }
 
-void UPlayerSkillBase::StartCooldown()
+bool UPlayerSkillBase::IsSkillInCooldown() const
 {
+	UGameplaySkillsComponent* SkillsComp = InstigatorSkillComponent.Get();
+	return SkillsComp ? SkillsComp->IsSkillInCooldown(SkillIndex) : false;
 }
 
-void UPlayerSkillBase::FinishCooldown()
+float UPlayerSkillBase::GetRemainingCooldown() const
 {
+	UGameplaySkillsComponent* SkillsComp = InstigatorSkillComponent.Get();
+	return SkillsComp ? SkillsComp->GetRemainingCooldown(SkillIndex) : 0.f;
 }
 
-void UPlayerSkillBase::CancelCooldown()
+void UPlayerSkillBase::StartCooldown()
 {
 }
 
-void UPlayerSkillBase::UpdateCooldown()
+void UPlayerSkillBase::CancelCooldown()
 {
 }
 
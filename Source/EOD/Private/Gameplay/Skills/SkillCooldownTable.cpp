@@ -0,0 +1,75 @@
+// Copyright 2018 Moikkai Games. All Rights Reserved.
+
+#include "SkillCooldownTable.h"
+
+void FSkillCooldownTable::StartCooldown(uint8 SkillIndex, float EndTime)
+{
+	if (!EndTimes.IsValidIndex(SkillIndex))
+	{
+		EndTimes.SetNumZeroed(SkillIndex + 1);
+	}
+
+	EndTimes[SkillIndex] = EndTime;
+
+	FCooldownEntry Entry;
+	Entry.EndTime = EndTime;
+	Entry.SkillIndex = SkillIndex;
+	CooldownHeap.HeapPush(Entry, FCooldownEntryPredicate());
+}
+
+bool FSkillCooldownTable::CancelCooldown(uint8 SkillIndex)
+{
+	if (!EndTimes.IsValidIndex(SkillIndex) || EndTimes[SkillIndex] == 0.f)
+	{
+		return false;
+	}
+
+	// The heap entry of the cooldown is left behind and discarded once it reaches the top
+	EndTimes[SkillIndex] = 0.f;
+	return true;
+}
+
+bool FSkillCooldownTable::GetNextEndTime(float& OutEndTime)
+{
+	DiscardStaleEntries();
+	if (CooldownHeap.Num() == 0)
+	{
+		return false;
+	}
+
+	OutEndTime = CooldownHeap.HeapTop().EndTime;
+	return true;
+}
+
+bool FSkillCooldownTable::PopExpiredCooldown(float CurrentTime, uint8& OutSkillIndex)
+{
+	DiscardStaleEntries();
+	if (CooldownHeap.Num() == 0 || CooldownHeap.HeapTop().EndTime > CurrentTime)
+	{
+		return false;
+	}
+
+	OutSkillIndex = CooldownHeap.HeapTop().SkillIndex;
+	EndTimes[OutSkillIndex] = 0.f;
+	CooldownHeap.HeapPopDiscard(FCooldownEntryPredicate(), false);
+	return true;
+}
+
+void FSkillCooldownTable::Reset()
+{
+	EndTimes.Reset();
+	CooldownHeap.Reset();
+}
+
+void FSkillCooldownTable::DiscardStaleEntries()
+{
+	while (CooldownHeap.Num() > 0)
+	{
+		const FCooldownEntry& Top = CooldownHeap.HeapTop();
+		if (EndTimes[Top.SkillIndex] == Top.EndTime)
+		{
+			break;
+		}
+		CooldownHeap.HeapPopDiscard(FCooldownEntryPredicate(), false);
+	}
+}
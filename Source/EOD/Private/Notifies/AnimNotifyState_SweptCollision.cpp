@@ -0,0 +1,182 @@
+// Copyright 2018 Moikkai Games. All Rights Reserved.
+
+#include "AnimNotifyState_SweptCollision.h"
+#include "CombatLibrary.h"
+#include "EODCharacterBase.h"
+#include "CombatZoneModeBase.h"
+#include "CombatManager.h"
+
+#include "Kismet/KismetSystemLibrary.h"
+#include "Components/SkeletalMeshComponent.h"
+
+DECLARE_CYCLE_STAT(TEXT("EOD SweptCollision"), STAT_EODSweptCollision, STATGROUP_EOD);
+
+static ACombatManager* GetCombatManager(USkeletalMeshComponent* MeshComp)
+{
+	UWorld* World = MeshComp ? MeshComp->GetWorld() : nullptr;
+	// Only process this notify if the current game mode is ACombatZoneModeBase
+	ACombatZoneModeBase* CombatZoneGameMode = World ? Cast<ACombatZoneModeBase>(World->GetAuthGameMode()) : nullptr;
+	return CombatZoneGameMode ? CombatZoneGameMode->GetCombatManager() : nullptr;
+}
+
+UAnimNotifyState_SweptCollision::UAnimNotifyState_SweptCollision(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
+{
+	BladeStart = FVector::ZeroVector;
+	BladeEnd = FVector(0.f, 0.f, 100.f);
+	BladeRadius = 10.f;
+	MaxSubStepDistance = 50.f;
+	MaxSweepsPerFrame = 4;
+}
+
+void UAnimNotifyState_SweptCollision::NotifyBegin(USkeletalMeshComponent* MeshComp, UAnimSequenceBase* Animation, float TotalDuration)
+{
+	Super::NotifyBegin(MeshComp, Animation, TotalDuration);
+
+	ACombatManager* CombatManager = GetCombatManager(MeshComp);
+	if (!CombatManager)
+	{
+		return;
+	}
+
+	// Restarting the notify state on the same mesh (e.g. a montage jumping back a section) starts a new swing
+	FSweptCollisionSwing& Swing = ActiveSwings.FindOrAdd(MeshComp);
+	Swing.LastSocketTransform = GetSocketTransform(MeshComp);
+	Swing.HitActors.Reset();
+	Swing.SwingId = CombatManager->GenerateSwingId();
+}
+
+void UAnimNotifyState_SweptCollision::NotifyTick(USkeletalMeshComponent* MeshComp, UAnimSequenceBase* Animation, float FrameDeltaTime)
+{
+	Super::NotifyTick(MeshComp, Animation, FrameDeltaTime);
+
+	FSweptCollisionSwing* Swing = ActiveSwings.Find(MeshComp);
+	if (Swing)
+	{
+		const FTransform CurrentSocketTransform = GetSocketTransform(MeshComp);
+		SweepBlade(MeshComp, *Swing, CurrentSocketTransform);
+		Swing->LastSocketTransform = CurrentSocketTransform;
+	}
+}
+
+void UAnimNotifyState_SweptCollision::NotifyEnd(USkeletalMeshComponent* MeshComp, UAnimSequenceBase* Animation)
+{
+	Super::NotifyEnd(MeshComp, Animation);
+
+	FSweptCollisionSwing Swing;
+	if (!ActiveSwings.RemoveAndCopyValue(MeshComp, Swing))
+	{
+		return;
+	}
+
+	// The blade has moved since the last tick, sweep the rest of the way to the end pose
+	SweepBlade(MeshComp, Swing, GetSocketTransform(MeshComp));
+
+	// Hits are only queued as they happen, so a swing that missed everything still has to report its miss once
+	ACombatManager* CombatManager = GetCombatManager(MeshComp);
+	if (CombatManager && Swing.HitActors.Num() == 0)
+	{
+		ScratchHitResults.Reset();
+		CombatManager->QueueMeleeAttack(MeshComp->GetOwner(), false, ScratchHitResults, SkillInfo, Swing.SwingId);
+	}
+
+	// Clean up swings of meshes that were destroyed mid swing
+	for (auto It = ActiveSwings.CreateIterator(); It; ++It)
+	{
+		if (!It.Key().IsValid())
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
+
+FTransform UAnimNotifyState_SweptCollision::GetSocketTransform(USkeletalMeshComponent* MeshComp) const
+{
+	return MeshComp->GetSocketTransform(SocketName, RTS_World);
+}
+
+void UAnimNotifyState_SweptCollision::SweepBlade(USkeletalMeshComponent* MeshComp, FSweptCollisionSwing& Swing, const FTransform& CurrentSocketTransform)
+{
+	SCOPE_CYCLE_COUNTER(STAT_EODSweptCollision);
+
+	UWorld* World = MeshComp->GetWorld();
+	ACombatManager* CombatManager = GetCombatManager(MeshComp);
+	if (!CombatManager)
+	{
+		return;
+	}
+
+	AActor* Owner = MeshComp->GetOwner();
+	// Test collision against where targets were on the owner's screen
+	FScopedCombatRewind CombatRewind(CombatManager, Owner);
+
+	// Split the frame movement into sub-steps so that a low tick rate doesn't make the blade skip over targets along its arc
+	const FVector LastTip = Swing.LastSocketTransform.TransformPosition(BladeEnd);
+	const FVector CurrentTip = CurrentSocketTransform.TransformPosition(BladeEnd);
+	const float TipDistance = FVector::Dist(LastTip, CurrentTip);
+	const int32 NumSubSteps = FMath::Clamp(FMath::CeilToInt(TipDistance / FMath::Max(MaxSubStepDistance, 1.f)), 1, FMath::Max(MaxSweepsPerFrame, 1));
+
+	const FVector LocalCenter = (BladeStart + BladeEnd) * 0.5f;
+	const FVector LocalAxis = BladeEnd - BladeStart;
+	const FQuat LocalRotation = FRotationMatrix::MakeFromZ(LocalAxis).ToQuat();
+	const float HalfHeight = LocalAxis.Size() * 0.5f * CurrentSocketTransform.GetMaximumAxisScale() + BladeRadius;
+
+	const FCollisionShape CollisionShape = FCollisionShape::MakeCapsule(BladeRadius, HalfHeight);
+	const FCollisionQueryParams Params = UCombatLibrary::GenerateCombatCollisionQueryParams(Owner);
+	const FCharacterSpatialHash& SpatialHash = CombatManager->GetCharacterSpatialHash();
+
+	ScratchHitResults.Reset();
+
+	FTransform SubStepStart = Swing.LastSocketTransform;
+	for (int32 SubStep = 1; SubStep <= NumSubSteps; SubStep++)
+	{
+		FTransform SubStepEnd;
+		SubStepEnd.Blend(Swing.LastSocketTransform, CurrentSocketTransform, (float)SubStep / (float)NumSubSteps);
+
+		const FVector Start = SubStepStart.TransformPosition(LocalCenter);
+		const FQuat StartRotation = SubStepStart.TransformRotation(LocalRotation);
+		FVector End = SubStepEnd.TransformPosition(LocalCenter);
+		const FQuat EndRotation = SubStepEnd.TransformRotation(LocalRotation);
+		// A sweep can only use a single rotation, so take the one halfway through the sub-step
+		const FQuat SweepRotation = FQuat::Slerp(StartRotation, EndRotation, 0.5f);
+		SubStepStart = SubStepEnd;
+
+		// Only do the physics sweep if some character is near enough to be hit
+		const FBox SweepBounds =
+			FCharacterSpatialHash::GetCapsuleBounds(Start, StartRotation, BladeRadius, HalfHeight) +
+			FCharacterSpatialHash::GetCapsuleBounds(End, EndRotation, BladeRadius, HalfHeight);
+		if (!SpatialHash.AnyInBox(SweepBounds.GetCenter(), FQuat::Identity, SweepBounds.GetExtent(), FCharacterQueryFilter(Owner)))
+		{
+			continue;
+		}
+
+		// If trace start and end position is same, the trace doesn't hit anything.
+		if (FVector::DistSquared(Start, End) < KINDA_SMALL_NUMBER)
+		{
+			End = Start + FVector(0.f, 0.f, 1.f);
+		}
+
+#if EOD_DRAWING_DEBUG_SHAPES_ENABLED
+		UKismetSystemLibrary::DrawDebugCapsule(MeshComp, End, HalfHeight, BladeRadius, SweepRotation.Rotator(), FLinearColor::White, 5.f, 1.f);
+#endif
+
+		SubStepHitResults.Reset();
+		CombatManager->RecordCombatSweep();
+		World->SweepMultiByChannel(SubStepHitResults, Start, End, SweepRotation, COLLISION_COMBAT, CollisionShape, Params);
+
+		// Every actor can only be hit once per swing
+		for (const FHitResult& HitResult : SubStepHitResults)
+		{
+			AActor* HitActor = HitResult.GetActor();
+			if (HitActor && !Swing.HitActors.Contains(HitActor))
+			{
+				Swing.HitActors.Add(HitActor);
+				ScratchHitResults.Add(HitResult);
+			}
+		}
+	}
+
+	if (ScratchHitResults.Num() > 0)
+	{
+		CombatManager->QueueMeleeAttack(Owner, true, ScratchHitResults, SkillInfo, Swing.SwingId);
+	}
+}
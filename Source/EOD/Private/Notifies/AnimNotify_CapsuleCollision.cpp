@@ -39,14 +39,23 @@ void UAnimNotify_CapsuleCollision::Notify(USkeletalMeshComponent* MeshComp, UAni
 		FQuat TransformedQuat = WorldTransform.TransformRotation(Rotation.Quaternion());
 
 		AActor* Owner = MeshComp->GetOwner();
+		// Test collision against where targets were on the owner's screen
+		FScopedCombatRewind CombatRewind(CombatManager, Owner);
 
 		FCollisionShape CollisionShape = FCollisionShape::MakeCapsule(Radius, HalfHeight);
 		FCollisionQueryParams Params = UCombatLibrary::GenerateCombatCollisionQueryParams(Owner);
 		TArray<FHitResult> HitResults;
 
-		// If trace start and end position is same, the trace doesn't hit anything.
-		FVector End = TransformedCenter + FVector(0.f, 0.f, 1.f);
-		bool bHit = World->SweepMultiByChannel(HitResults, TransformedCenter, End, TransformedQuat, COLLISION_COMBAT, CollisionShape, Params);
-		CombatManager->OnMeleeAttack(Owner, bHit, HitResults, SkillInfo);
+		// Only do the physics sweep if some character is near enough to be hit
+		bool bHit = false;
+		const FCharacterSpatialHash& SpatialHash = CombatManager->GetCharacterSpatialHash();
+		if (SpatialHash.AnyInCapsule(TransformedCenter, TransformedQuat, Radius, HalfHeight, FCharacterQueryFilter(Owner)))
+		{
+			// If trace start and end position is same, the trace doesn't hit anything.
+			FVector End = TransformedCenter + FVector(0.f, 0.f, 1.f);
+			CombatManager->RecordCombatSweep();
+			bHit = World->SweepMultiByChannel(HitResults, TransformedCenter, End, TransformedQuat, COLLISION_COMBAT, CollisionShape, Params);
+		}
+		CombatManager->QueueMeleeAttack(Owner, bHit, HitResults, SkillInfo, CombatManager->GenerateSwingId());
 	}
 }
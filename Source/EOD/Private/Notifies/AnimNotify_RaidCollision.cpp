@@ -12,6 +12,48 @@
 #include "Kismet/KismetSystemLibrary.h"
 #include "Components/SkeletalMeshComponent.h"
 
+FBakedRaidCapsule::FBakedRaidCapsule(const FRaidCapsule& Capsule)
+{
+	// RaiderZ capsules are rotated by 90 degrees about the up axis relative to our meshes
+	FVector CorrectedBottom = Capsule.Bottom.RotateAngleAxis(90.f, FVector(0.f, 0.f, 1.f));
+	FVector CorrectedTop = Capsule.Top.RotateAngleAxis(90.f, FVector(0.f, 0.f, 1.f));
+	FVector HalfHeightVector = (CorrectedTop - CorrectedBottom) / 2;
+
+	Center = CorrectedBottom + HalfHeightVector;
+	Rotation = FRotationMatrix::MakeFromZ(HalfHeightVector).ToQuat();
+	Radius = Capsule.Radius;
+	HalfHeight = HalfHeightVector.Size();
+}
+
+void UAnimNotify_RaidCollision::PostLoad()
+{
+	Super::PostLoad();
+
+	// Notifies saved before capsules were baked
+	if (BakedCapsules.Num() != CollisionCapsules.Num())
+	{
+		BakeCollisionCapsules();
+	}
+}
+
+#if WITH_EDITOR
+void UAnimNotify_RaidCollision::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	BakeCollisionCapsules();
+}
+#endif
+
+void UAnimNotify_RaidCollision::BakeCollisionCapsules()
+{
+	BakedCapsules.Reset(CollisionCapsules.Num());
+	for (const FRaidCapsule& Capsule : CollisionCapsules)
+	{
+		BakedCapsules.Add(FBakedRaidCapsule(Capsule));
+	}
+}
+
 void UAnimNotify_RaidCollision::Notify(USkeletalMeshComponent* MeshComp, UAnimSequenceBase* Animation)
 {
 	UWorld* World = MeshComp ? MeshComp->GetWorld() : nullptr;
@@ -19,22 +61,14 @@ void UAnimNotify_RaidCollision::Notify(USkeletalMeshComponent* MeshComp, UAnimSe
 #if EOD_DRAWING_DEBUG_SHAPES_ENABLED
 	if (World)
 	{
-		for (FRaidCapsule& Capsule : CollisionCapsules)
+		const FTransform& WorldTransform = MeshComp->GetComponentTransform();
+		for (const FBakedRaidCapsule& Capsule : BakedCapsules)
 		{
-			FTransform WorldTransform = MeshComp->GetComponentTransform();
-
-			FVector CorrectedBottom = Capsule.Bottom.RotateAngleAxis(90.f, FVector(0.f, 0.f, 1.f));
-			FVector CorrectedTop = Capsule.Top.RotateAngleAxis(90.f, FVector(0.f, 0.f, 1.f));
-			FVector HalfHeightVector = (CorrectedTop - CorrectedBottom) / 2;
-			FVector NormalizedHeightVector = HalfHeightVector.GetSafeNormal();
-			FVector Center = CorrectedBottom + HalfHeightVector;
-			FRotator CapsuleRotation = FRotationMatrix::MakeFromZ(HalfHeightVector).Rotator();
-
 			// Transformation from object space to world space
-			FVector TransformedCenter = WorldTransform.TransformPosition(Center);
-			FRotator TransformedRotation = WorldTransform.TransformRotation(CapsuleRotation.Quaternion()).Rotator();
+			FVector TransformedCenter = WorldTransform.TransformPosition(Capsule.Center);
+			FRotator TransformedRotation = WorldTransform.TransformRotation(Capsule.Rotation).Rotator();
 
-			UKismetSystemLibrary::DrawDebugCapsule(MeshComp, TransformedCenter, HalfHeightVector.Size(), Capsule.Radius, TransformedRotation, FLinearColor::White, 5.f, 1.f);
+			UKismetSystemLibrary::DrawDebugCapsule(MeshComp, TransformedCenter, Capsule.HalfHeight, Capsule.Radius, TransformedRotation, FLinearColor::White, 5.f, 1.f);
 		}
 	}
 #endif
@@ -49,31 +83,36 @@ void UAnimNotify_RaidCollision::Notify(USkeletalMeshComponent* MeshComp, UAnimSe
 			return;
 		}
 
-		for (FRaidCapsule& Capsule : CollisionCapsules)
-		{
-			FTransform WorldTransform = MeshComp->GetComponentTransform();
+		AActor* Owner = MeshComp->GetOwner();
+		// Test collision against where targets were on the owner's screen
+		FScopedCombatRewind CombatRewind(CombatManager, Owner);
+		const FTransform& WorldTransform = MeshComp->GetComponentTransform();
+		FCollisionQueryParams Params = UCombatLibrary::GenerateCombatCollisionQueryParams(Owner);
+		const FCharacterSpatialHash& SpatialHash = CombatManager->GetCharacterSpatialHash();
+		TArray<FHitResult> HitResults;
 
-			FVector CorrectedBottom = Capsule.Bottom.RotateAngleAxis(90.f, FVector(0.f, 0.f, 1.f));
-			FVector CorrectedTop = Capsule.Top.RotateAngleAxis(90.f, FVector(0.f, 0.f, 1.f));
-			FVector HalfHeightVector = (CorrectedTop - CorrectedBottom) / 2;
-			FVector NormalizedHeightVector = HalfHeightVector.GetSafeNormal();
-			FVector Center = CorrectedBottom + HalfHeightVector;
-			FRotator CapsuleRotation = FRotationMatrix::MakeFromZ(HalfHeightVector).Rotator();
+		// All capsules of this notify are a single swing
+		const uint32 SwingId = CombatManager->GenerateSwingId();
 
+		for (const FBakedRaidCapsule& Capsule : BakedCapsules)
+		{
 			// Transformation from object space to world space
-			FVector TransformedCenter = WorldTransform.TransformPosition(Center);
-			FRotator TransformedRotation = WorldTransform.TransformRotation(CapsuleRotation.Quaternion()).Rotator();
-
-			AActor* Owner = MeshComp->GetOwner();
+			FVector TransformedCenter = WorldTransform.TransformPosition(Capsule.Center);
+			FQuat TransformedQuat = WorldTransform.TransformRotation(Capsule.Rotation);
 
-			FCollisionShape CollisionShape = FCollisionShape::MakeCapsule(Capsule.Radius, HalfHeightVector.Size());
-			FCollisionQueryParams Params = UCombatLibrary::GenerateCombatCollisionQueryParams(Owner);
-			TArray<FHitResult> HitResults;
+			FCollisionShape CollisionShape = FCollisionShape::MakeCapsule(Capsule.Radius, Capsule.HalfHeight);
+			HitResults.Reset();
 
-			// If trace start and end position is same, the trace doesn't hit anything.
-			FVector End = TransformedCenter + FVector(0.f, 0.f, 1.f);
-			bool bHit = World->SweepMultiByChannel(HitResults, TransformedCenter, End, TransformedRotation.Quaternion(), COLLISION_COMBAT, CollisionShape, Params);
-			CombatManager->OnMeleeAttack(Owner, bHit, HitResults, SkillInfo);
+			// Only do the physics sweep if some character is near enough to be hit
+			bool bHit = false;
+			if (SpatialHash.AnyInCapsule(TransformedCenter, TransformedQuat, Capsule.Radius, Capsule.HalfHeight, FCharacterQueryFilter(Owner)))
+			{
+				// If trace start and end position is same, the trace doesn't hit anything.
+				FVector End = TransformedCenter + FVector(0.f, 0.f, 1.f);
+				CombatManager->RecordCombatSweep();
+				bHit = World->SweepMultiByChannel(HitResults, TransformedCenter, End, TransformedQuat, COLLISION_COMBAT, CollisionShape, Params);
+			}
+			CombatManager->QueueMeleeAttack(Owner, bHit, HitResults, SkillInfo, SwingId);
 		}
 	}
 }
@@ -11,6 +11,78 @@
 #include "Components/ProgressBar.h"
 #include "Kismet/KismetSystemLibrary.h"
 
+/**
+ * Modifier source IDs of the equipment slots. Object unique IDs are indices into the global object array,
+ * so they never reach this range.
+ */
+namespace EquipmentModifierSourceID
+{
+	constexpr uint32 PrimaryWeapon = 0xFFFFFF00;
+	constexpr uint32 SecondaryWeapon = 0xFFFFFF01;
+	constexpr uint32 FirstArmor = 0xFFFFFF10;
+
+	FORCEINLINE uint32 Armor(EArmorType ArmorType)
+	{
+		return FirstArmor + (uint32)ArmorType;
+	}
+}
+
+/** A stat bonus of an equipment table row */
+struct FStatBonus
+{
+	EStatId StatId;
+
+	float Value;
+};
+
+/** Appends a flat modifier for each non-zero stat bonus, and for each additional stat bonus of an equipment */
+static void AddStatBonuses(TArrayView<const FStatBonus> StatBonuses, const TMap<FName, float>& AdditionalStatsBonus, FStatModifierEntries& OutModifierEntries)
+{
+	for (const FStatBonus& StatBonus : StatBonuses)
+	{
+		if (StatBonus.Value != 0.f)
+		{
+			OutModifierEntries.Emplace(StatBonus.StatId, FStatModifier(StatBonus.Value, EStatModType::Flat));
+		}
+	}
+
+	// Additional bonuses are keyed by the stat names in StatInfos
+	for (const TPair<FName, float>& StatBonus : AdditionalStatsBonus)
+	{
+		const EStatId StatId = FindStatIdByName(StatBonus.Key);
+		if (StatId != EStatId::Num && StatBonus.Value != 0.f)
+		{
+			OutModifierEntries.Emplace(StatId, FStatModifier(StatBonus.Value, EStatModType::Flat));
+		}
+	}
+}
+
+static void GetWeaponStatModifiers(const FWeaponTableRow& WeaponData, FStatModifierEntries& OutModifierEntries)
+{
+	const FStatBonus StatBonuses[] =
+	{
+		{ EStatId::PhysicalAttack, (float)WeaponData.PhysicalAttack },
+		{ EStatId::MagickalAttack, (float)WeaponData.MagickalAttack },
+		{ EStatId::PhysicalCritRate, WeaponData.PhysicalCritRate },
+		{ EStatId::MagickalCritRate, WeaponData.MagickalCritRate },
+		{ EStatId::PhysicalCritBonus, WeaponData.PhysicalCritBonusDamage },
+		{ EStatId::MagickalCritBonus, WeaponData.MagickalCritBonusDamage }
+	};
+	AddStatBonuses(StatBonuses, WeaponData.AdditionalStatsBonus, OutModifierEntries);
+}
+
+static void GetArmorStatModifiers(const FArmorTableRow& ArmorData, FStatModifierEntries& OutModifierEntries)
+{
+	const FStatBonus StatBonuses[] =
+	{
+		{ EStatId::PhysicalResistance, (float)ArmorData.PhysicalResistance },
+		{ EStatId::MagickalResistance, (float)ArmorData.MagickalResistance },
+		{ EStatId::PhysicalCritRate, ArmorData.PhysicalCritRate },
+		{ EStatId::MagickalCritRate, ArmorData.MagickalCritRate }
+	};
+	AddStatBonuses(StatBonuses, ArmorData.AdditionalStatsBonus, OutModifierEntries);
+}
+
 UPlayerStatsComponent::UPlayerStatsComponent(const FObjectInitializer& ObjectInitializer) :
 	Super(ObjectInitializer)
 {
@@ -45,6 +117,8 @@ void UPlayerStatsComponent::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>
 
 void UPlayerStatsComponent::AddPrimaryWeaponStats(FWeaponTableRow* WeaponData)
 {
+	FScopedStatTransaction StatTransaction(this);
+
 	if (PrimaryWeaponData && PrimaryWeaponData == WeaponData)
 	{
 		return;
@@ -55,10 +129,19 @@ void UPlayerStatsComponent::AddPrimaryWeaponStats(FWeaponTableRow* WeaponData)
 	}
 
 	PrimaryWeaponData = WeaponData;
+
+	if (WeaponData)
+	{
+		FStatModifierEntries ModifierEntries;
+		GetWeaponStatModifiers(*WeaponData, ModifierEntries);
+		AddStatModifiers(EquipmentModifierSourceID::PrimaryWeapon, ModifierEntries);
+	}
 }
 
 void UPlayerStatsComponent::AddSecondaryWeaponStats(FWeaponTableRow* WeaponData)
 {
+	FScopedStatTransaction StatTransaction(this);
+
 	if (SecondaryWeaponData && SecondaryWeaponData == WeaponData)
 	{
 		return;
@@ -69,20 +152,37 @@ void UPlayerStatsComponent::AddSecondaryWeaponStats(FWeaponTableRow* WeaponData)
 	}
 
 	SecondaryWeaponData = WeaponData;
+
+	if (WeaponData)
+	{
+		FStatModifierEntries ModifierEntries;
+		GetWeaponStatModifiers(*WeaponData, ModifierEntries);
+		AddStatModifiers(EquipmentModifierSourceID::SecondaryWeapon, ModifierEntries);
+	}
 }
 
 void UPlayerStatsComponent::RemovePrimaryWeaponStats()
 {
 	PrimaryWeaponData = nullptr;
+	RemoveAllStatModifiers(EquipmentModifierSourceID::PrimaryWeapon);
 }
 
 void UPlayerStatsComponent::RemoveSecondaryWeaponStats()
 {
 	SecondaryWeaponData = nullptr;
+	RemoveAllStatModifiers(EquipmentModifierSourceID::SecondaryWeapon);
 }
 
 void UPlayerStatsComponent::AddArmorStats(FArmorTableRow* ArmorData)
 {
+	if (!ArmorData)
+	{
+		return;
+	}
+
+	// Replacing an armor removes the stats of the old one first, both should reach listeners as a single change
+	FScopedStatTransaction StatTransaction(this);
+
 	if (ArmorsData.Contains(ArmorData->ArmorType))
 	{
 		RemoveArmorStats(ArmorData->ArmorType);
@@ -90,14 +190,17 @@ void UPlayerStatsComponent::AddArmorStats(FArmorTableRow* ArmorData)
 
 	ArmorsData.Add(ArmorData->ArmorType, ArmorData);
 
-	//~ @todo add armor stats to player stats
+	FStatModifierEntries ModifierEntries;
+	GetArmorStatModifiers(*ArmorData, ModifierEntries);
+	AddStatModifiers(EquipmentModifierSourceID::Armor(ArmorData->ArmorType), ModifierEntries);
 }
 
 void UPlayerStatsComponent::RemoveArmorStats(EArmorType ArmorType)
 {
-	ArmorsData.Remove(ArmorType);
+	FScopedStatTransaction StatTransaction(this);
 
-	//~ @todo remove armor stats from player stats
+	ArmorsData.Remove(ArmorType);
+	RemoveAllStatModifiers(EquipmentModifierSourceID::Armor(ArmorType));
 }
 
 void UPlayerStatsComponent::LoadPlayerStats()
@@ -122,6 +225,9 @@ void UPlayerStatsComponent::LoadPlayerStats()
 		return;
 	}
 
+	// Broadcast every stat change once, after all stats have been loaded
+	FScopedStatTransaction StatTransaction(this);
+
 	Health.SetMaxValue(TableRow->Health);
 	Health.RefillCurrentValue();
 
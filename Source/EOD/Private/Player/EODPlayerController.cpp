@@ -375,7 +375,7 @@ void AEODPlayerController::InitSkillBarWidget()
 		if (SkillBarWidget)
 		{
 			SkillBarWidget->SetSkillOwnerComponent(SkillsComp);
-			SkillBarWidget->InitializeSkillBarLayout(SkillsComp->GetSkillBarMap(), SkillsComp->GetSkillsMap());
+			SkillBarWidget->InitializeSkillBarLayout(SkillsComp->GetSkillBarMap(), SkillsComp->GetSkills());
 		}
 	}	
 }
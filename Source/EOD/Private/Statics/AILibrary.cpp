@@ -1,6 +1,8 @@
 // Copyright 2018 Moikkai Games. All Rights Reserved.
 
 #include "AILibrary.h"
+#include "EODCharacterBase.h"
+#include "StatsComponentBase.h"
 
 const FName UAILibrary::BBKey_bHasEnemyTarget			= FName("bHasEnemyTarget");
 const FName UAILibrary::BBKey_TargetEnemy				= FName("TargetEnemy");
@@ -15,3 +17,31 @@ const FName UAILibrary::BBKey_MostWeightedSkillID		= FName("MostWeightedSkillID"
 UAILibrary::UAILibrary(const FObjectInitializer & ObjectInitializer)
 {
 }
+
+FAITargetSnapshot::FAITargetSnapshot() :
+	Location(FVector::ZeroVector),
+	ForwardVector(FVector::ForwardVector),
+	HealthRatio(1.f),
+	CCImmunities(0),
+	bBlocking(false),
+	bDodging(false),
+	bUsingSkill(false),
+	bHasBeenHit(false)
+{
+}
+
+void FAITargetSnapshot::Capture(const AEODCharacterBase* Character)
+{
+	check(Character);
+
+	const UStatsComponentBase* StatsComp = Character->GetStatsComponent();
+
+	Location = Character->GetActorLocation();
+	ForwardVector = Character->GetActorForwardVector();
+	HealthRatio = Character->Health.MaxValue > 0 ? FMath::Clamp((float)Character->Health.CurrentValue / Character->Health.MaxValue, 0.f, 1.f) : 1.f;
+	CCImmunities = StatsComp ? StatsComp->CCImmunities.GetImmunityMask() : 0;
+	bBlocking = Character->IsBlocking();
+	bDodging = Character->IsDodging();
+	bUsingSkill = Character->IsUsingAnySkill();
+	bHasBeenHit = Character->HasBeenHit();
+}
@@ -104,3 +104,10 @@ bool UCharacterLibrary::AreEnemies(AEODCharacterBase * CharacterOne, AEODCharact
 
 	return true;
 }
+
+FMaskFilter UCharacterLibrary::GetFactionMaskFilter(EFaction Faction)
+{
+	const uint8 FactionIndex = static_cast<uint8>(Faction);
+	check(FactionIndex < 6);
+	return static_cast<FMaskFilter>(1 << FactionIndex);
+}
@@ -7,6 +7,7 @@
 const float UCombatLibrary::PhysicalCritMultiplier = 1.6f;
 const float UCombatLibrary::MagickalCritMultiplier = 1.4f;
 const float UCombatLibrary::BlockDetectionAngle = 60.f;
+const float UCombatLibrary::DamageResistanceScale = 100.f;
 
 UCombatLibrary::UCombatLibrary(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
 {
@@ -23,13 +24,19 @@ FCollisionQueryParams UCombatLibrary::GenerateCombatCollisionQueryParams(const A
 	Params.MobilityType = MobilityType;
 	Params.bTraceComplex = false;
 	Params.TraceTag = TraceTag;
-	// @todo mask filter for teams.
+
+	// Skip the bodies of characters that the querying character can never damage
+	const AEODCharacterBase* CharacterToIgnore = Cast<AEODCharacterBase>(ActorToIgnore);
+	if (CharacterToIgnore)
+	{
+		Params.IgnoreMask = CharacterToIgnore->GetCombatIgnoreMask();
+	}
 
 	return Params;
 }
 
 float UCombatLibrary::CalculateDamage(float Attack, float Defense)
 {
-	// @todo definition
-	return Attack;
+	// Negative defense is treated as no defense rather than amplifying damage
+	return Attack * DamageResistanceScale / (DamageResistanceScale + FMath::Max(Defense, 0.f));
 }
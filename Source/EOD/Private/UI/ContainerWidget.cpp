@@ -20,6 +20,7 @@ UContainerWidget::UContainerWidget(const FObjectInitializer& ObjectInitializer)
 	ContainerType = EContainerType::None;
 	bDisplaySubTextAsRatio = false;
 	bSubTextVisible = true;
+	CooldownEndTime = 0.f;
 }
 
 bool UContainerWidget::Initialize()
@@ -28,6 +29,7 @@ bool UContainerWidget::Initialize()
 	{
 		SubText->SetVisibility(ESlateVisibility::Hidden);
 		CooldownText->SetVisibility(ESlateVisibility::Hidden);
+		CooldownText->TextDelegate.BindUFunction(this, GET_FUNCTION_NAME_CHECKED(UContainerWidget, GetCooldownText));
 
 		Internal_InitializeContainer();
 		return true;
@@ -308,11 +310,8 @@ void UContainerWidget::DisableCooldownText()
 			if (SkillsComp)
 			{
 				uint8 SkillBarIndex = SkillBarWidget->GetIndexOfSkillContainer(this);
-				const TMap<uint8, uint8>& SkillBarMap = SkillsComp->GetSkillBarMap();
-				const TMap<uint8, UGameplaySkillBase*>& SkillsMap = SkillsComp->GetSkillsMap();
-				
-				uint8 SkillIndex = SkillBarMap.Contains(SkillBarIndex) ? SkillBarMap[SkillBarIndex] : 0;
-				UPlayerSkillBase* Skill = SkillsMap.Contains(SkillIndex) ? Cast<UPlayerSkillBase>(SkillsMap[SkillIndex]) : nullptr;
+				uint8 SkillIndex = SkillsComp->GetSkillBarMap().FindRef(SkillBarIndex);
+				UPlayerSkillBase* Skill = Cast<UPlayerSkillBase>(SkillsComp->GetSkill(SkillIndex));
 
 				if (Skill)
 				{
@@ -394,10 +393,14 @@ void UContainerWidget::UpdateCooldown(float CooldownTimeRemaining)
 			EnableCooldownText();
 		}
 
-		if (CooldownText)
-		{
-			CooldownText->SetText(FText::FromString(FString::FromInt(CooldownTimeRemaining)));
-			CooldownRemaining = CooldownTimeRemaining;
-		}
+		UWorld* World = GetWorld();
+		CooldownEndTime = World ? World->GetTimeSeconds() + CooldownTimeRemaining : 0.f;
 	}
 }
+
+FText UContainerWidget::GetCooldownText() const
+{
+	UWorld* World = GetWorld();
+	const float CooldownTimeRemaining = World ? CooldownEndTime - World->GetTimeSeconds() : 0.f;
+	return FText::AsNumber(FMath::Max(FMath::CeilToInt(CooldownTimeRemaining), 0));
+}
@@ -70,7 +70,7 @@ bool UDynamicSkillBarWidget::OnContainerDropped(UContainerWidget* FromContainer,
 			ToChildContainer->SetContainerData(FromContainer->GetContainerData());
 			
 			uint8 SkillIndex = SkillsComp->GetSkillBarMap()[SkillBarIndex];
-			UPlayerSkillBase* Skill = Cast<UPlayerSkillBase>(SkillsComp->GetSkillsMap()[SkillIndex]);
+			UPlayerSkillBase* Skill = Cast<UPlayerSkillBase>(SkillsComp->GetSkill(SkillIndex));
 			check(Skill);
 			bool bCanActivate = Skill->CanPlayerActivateThisSkill();
 			if (bCanActivate)
@@ -219,7 +219,7 @@ void UDynamicSkillBarWidget::SetSkillOwnerComponent(UPlayerSkillsComponent* Skil
 	OwnerSkillsComponent = SkillsComponent;
 }
 
-void UDynamicSkillBarWidget::InitializeSkillBarLayout(const TMap<uint8, uint8>& SkillBarMap, const TMap<uint8, UGameplaySkillBase*>& SkillsMap)
+void UDynamicSkillBarWidget::InitializeSkillBarLayout(const TMap<uint8, uint8>& SkillBarMap, const TArray<UGameplaySkillBase*>& Skills)
 {
 	TArray<uint8> Keys;
 	SkillBarMap.GetKeys(Keys);
@@ -227,9 +227,9 @@ void UDynamicSkillBarWidget::InitializeSkillBarLayout(const TMap<uint8, uint8>&
 	for (uint8 Key : Keys)
 	{
 		uint8 SkillKey = SkillBarMap[Key];
-		if (SkillsMap.Contains(SkillKey))
+		if (Skills.IsValidIndex(SkillKey))
 		{
-			UPlayerSkillBase* Skill = Cast<UPlayerSkillBase>(SkillsMap[SkillKey]);
+			UPlayerSkillBase* Skill = Cast<UPlayerSkillBase>(Skills[SkillKey]);
 			UContainerWidget* Cont = GetContainerAtIndex(Key);
 			if (Skill && Cont)
 			{
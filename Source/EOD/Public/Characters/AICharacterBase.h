@@ -71,32 +71,36 @@ public:
 	//  Crowd Control Effects
 	// --------------------------------------
 
+	/** Removes 'stun' crowd control effect from this character */
+	virtual void CCERemoveStun() override;
+
+	/** Removes 'freeze' crowd control effect from this character */
+	virtual void CCEUnfreeze() override;
+
+	/** Removes 'knock-down' crowd control effect from this character */
+	virtual void CCEEndKnockdown() override;
+
+protected:
+
 	/** Flinch this character (visual feedback) */
-	virtual bool CCEFlinch(const float BCAngle) override;
+	virtual bool ApplyFlinch(const float BCAngle) override;
 
 	/** Interrupt this character's current action */
-	virtual bool CCEInterrupt(const float BCAngle) override;
+	virtual bool ApplyInterrupt(const float BCAngle) override;
 
 	/** Applies stun to this character */
-	virtual bool CCEStun(const float Duration) override;
-
-	/** Removes 'stun' crowd control effect from this character */
-	virtual void CCERemoveStun() override;
+	virtual bool ApplyStun(const float Duration) override;
 
 	/** Freeze this character */
-	virtual bool CCEFreeze(const float Duration) override;
+	virtual bool ApplyFreeze(const float Duration) override;
 
-	/** Removes 'freeze' crowd control effect from this character */
-	virtual void CCEUnfreeze() override;
-	
 	/** Knockdown this character */
-	virtual bool CCEKnockdown(const float Duration) override;
-	
-	/** Removes 'knock-down' crowd control effect from this character */
-	virtual void CCEEndKnockdown() override;
-	
+	virtual bool ApplyKnockdown(const float Duration) override;
+
 	/** Knockback this character */
-	virtual bool CCEKnockback(const float Duration, const FVector& ImpulseDirection) override;
+	virtual bool ApplyKnockback(const float Duration, const FVector& ImpulseDirection) override;
+
+public:
 
 	// --------------------------------------
 	//  Utility
@@ -211,6 +215,8 @@ public:
 
 	virtual bool IsEnemyOf(ICombatInterface* TargetCI) const override;
 
+	virtual FMaskFilter GetCombatIgnoreMask() const override;
+
 	/** Returns the sound that should be played when this character hits a physical surface */
 	virtual USoundBase* GetMeleeHitSound(const TEnumAsByte<EPhysicalSurface> HitSurface, const bool bCritHit) const;
 
@@ -3,9 +3,48 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "AILibrary.h"
+#include "CombatLibrary.h"
 #include "Characters/Components/GameplaySkillsComponent.h"
 #include "AISkillsComponent.generated.h"
 
+class UAISkillBase;
+class ACombatManager;
+
+/** Properties that the skills of an AI character are bucketed by for skill selection */
+enum class EAISkillProperty : uint8
+{
+	/** Every skill */
+	Any,
+	Unblockable,
+	Undodgable,
+	/** Skills that interrupt the target */
+	Interrupt,
+	/** Skills that apply a crowd control effect other than flinch */
+	CCE,
+	/** Skills that only make the target flinch */
+	Normal,
+	Count
+};
+
+/** What skill selection needs to know about the skill stored at a bit of a skill mask */
+struct FAISkillSlot
+{
+	FName SkillGroup;
+
+	/** Damage of the skill relative to the attack of its instigator */
+	float DamageFactor;
+
+	ECrowdControlEffect CCEffect;
+
+	FAISkillSlot() :
+		SkillGroup(NAME_None),
+		DamageFactor(0.f),
+		CCEffect(ECrowdControlEffect::Flinch)
+	{
+	}
+};
+
 /**
  * 
  */
@@ -45,6 +84,8 @@ public:
 
 	virtual void CancelAllActiveSkills() override;
 
+	virtual void CancelSkillsWithTag(FGameplayTag Tag) override;
+
 	virtual bool CanUseAnySkill() const override;
 
 	virtual bool CanUseSkill(uint8 SkillIndex, UGameplaySkillBase* Skill = nullptr) override;
@@ -55,11 +96,21 @@ public:
 	/** Event called when a skill gets finished */
 	virtual void OnSkillFinished(uint8 SkillIndex, FName SkillGroup, UGameplaySkillBase* Skill) override;
 
+	virtual bool GetAttackInfo(FName SkillGroup, int32 CollisionIndex, FAttackInfo& OutAttackInfo) override;
+
+	/** Finishes the skill at SkillIndex if it is still active. Called when the skill timer expires */
+	void FinishActiveSkill(uint8 SkillIndex);
+
+	/** Returns the timer that finishes the skill currently being used by this character */
+	FORCEINLINE FTimerHandle& GetSkillTimerHandle() { return SkillTimerHandle; }
+
+	/** Returns the melee or ranged attack skill with the highest utility against the given enemy */
 	FName GetMostWeightedSkillID(const AEODCharacterBase* TargetCharacter) const;
 
-	/** Returns the melee attack skill that is more appropriate to use in current state against the given enemy */
+	/** Returns the melee attack skill with the highest utility against the given enemy */
 	FName GetMostWeightedMeleeSkillID(const AEODCharacterBase* TargetCharacter) const;
 
+	/** Returns the ranged attack skill with the highest utility against the given enemy */
 	FName GetMostWeightedRangedSkillID(const AEODCharacterBase* TargetCharacter) const;
 
 	FName GetHealingSkillID(bool bPartyHeal = false) const;
@@ -72,6 +123,9 @@ public:
 
 protected:
 
+	/** Makes the skill available for selection again */
+	virtual void OnSkillCooldownFinished(uint8 SkillIndex) override;
+
 	// --------------------------------------
 	//  Pseudo Constants
 	// --------------------------------------
@@ -79,6 +133,14 @@ protected:
 	UPROPERTY(EditAnywhere, Category = Skills, BlueprintReadOnly)
 	float MaxMeleeRange;
 
+	/** Data table of FAISkillUtilityTableRow that attack skills are scored with. Default weights are used if this is not set */
+	UPROPERTY(EditAnywhere, Category = Skills, BlueprintReadOnly)
+	UDataTable* SkillUtilityDataTable;
+
+	/** Row of SkillUtilityDataTable used by this character */
+	UPROPERTY(EditAnywhere, Category = Skills, BlueprintReadOnly)
+	FName SkillUtilityRowName;
+
 	// --------------------------------------
 	//  Cache
 	// --------------------------------------
@@ -104,56 +166,47 @@ protected:
 	UPROPERTY(Transient, Category = Skills, BlueprintReadOnly)
 	TArray<FName> DebuffSkills;
 
+	// --------------------------------------
+	//  Skill Selection
+	// --------------------------------------
+
+	/** Maximum number of skills an AI character can have, i.e., the number of bits in a skill mask */
+	static const int32 MaxSkills = 64;
+
+	static const int32 NumSkillEffects = (int32)ESkillEffect::DebuffEnemy + 1;
+
+	/**
+	 * Masks of skills for every skill effect and skill property, generated by GenerateSkillTypesList.
+	 * The skill with skill index N is stored in bit N - 1 of a mask.
+	 */
+	uint64 SkillBuckets[NumSkillEffects][(int32)EAISkillProperty::Count];
+
+	/** Mask of skills that are not in cooldown */
+	uint64 AvailableSkillsMask;
+
+	/** The skill stored at each bit of a skill mask */
+	TArray<FAISkillSlot> SkillSlots;
+
+	/** Weights loaded from SkillUtilityDataTable */
+	UPROPERTY(Transient)
+	FAISkillUtilityTableRow SkillUtilityWeights;
+
 private:
 
-	FName GetRandomUnblockableSkill(const TArray<FName>& SkillSource, const TArray<FName>& SkillsToIgnore) const;
-	FName GetRandomUndodgableSkill(const TArray<FName>& SkillSource, const TArray<FName>& SkillsToIgnore) const;
-	FName GetRandomInterruptSkill(const TArray<FName>& SkillSource, const TArray<FName>& SkillsToIgnore) const;
-	FName GetRandomCCESkill(const TArray<FName>& SkillSource, const TArray<FName>& SkillsToIgnore) const;
-	FName GetRandomNormalSkill(const TArray<FName>& SkillSource, const TArray<FName>& SkillsToIgnore) const;
-	FName GetAnyRandomSkill(const TArray<FName>& SkillSource, const TArray<FName>& SkillsToIgnore) const;
+	/** Timer that finishes the skill currently being used by this character. Kept here because AI skill objects are shared between AI characters */
+	FTimerHandle SkillTimerHandle;
 
-	inline TArray<FName> GetAvailableSkills(const TArray<FName>& SkillSource, const TArray<FName>& SkillsToIgnore) const;
-	inline FName GetRandomName(const TArray<FName>& NameArray) const;
+	FORCEINLINE static uint64 GetSkillMask(uint8 SkillIndex) { return SkillIndex > 0 && SkillIndex <= MaxSkills ? (uint64)1 << (SkillIndex - 1) : 0; }
 
-};
+	/** Returns a random skill with the given effect and property that is not in cooldown and not in SkillsToIgnoreMask. Returns NAME_None if there is no such skill */
+	FName GetRandomSkill(ESkillEffect SkillEffect, EAISkillProperty SkillProperty, uint64 SkillsToIgnoreMask = 0) const;
 
-inline TArray<FName> UAISkillsComponent::GetAvailableSkills(const TArray<FName>& SkillSource, const TArray<FName>& SkillsToIgnore) const
-{
-	if (SkillSource == SkillsToIgnore)
-	{
-		return TArray<FName>();
-	}
+	/** Scores every skill in SkillMask against the current state of TargetCharacter in a single pass and returns the skill with the highest utility */
+	FName GetHighestUtilitySkill(uint64 SkillMask, const AEODCharacterBase* TargetCharacter) const;
 
-	if (SkillsToIgnore.Num() == 0)
-	{
-		return SkillSource;
-	}
-	else
-	{
-		TArray<FName> AvailableSkills;
-		for (const FName& Key : SkillSource)
-		{
-			if (!SkillsToIgnore.Contains(Key))
-			{
-				AvailableSkills.Add(Key);
-			}
-		}
-		return AvailableSkills;
-	}
-}
+	/** Picks a random skill from SkillMask using the decision stream of the combat manager, so skill selection is reproducible for a given combat random seed */
+	FName GetRandomSkillFromMask(uint64 SkillMask) const;
 
-inline FName UAISkillsComponent::GetRandomName(const TArray<FName>& NameArray) const
-{
-	int32 ArraySize = NameArray.Num();
-	if (ArraySize > 0)
-	{
-		int32 RandomIndex = FMath::RandRange(0, ArraySize - 1);
-		FName RandomName = NameArray[RandomIndex];
-		return RandomName;
-	}
-	else
-	{
-		return NAME_None;
-	}
-}
+	ACombatManager* GetCombatManager() const;
+
+};
@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "CharacterLibrary.h"
+#include "SkillCooldownTable.h"
 
 #include "GameplayTagContainer.h"
 #include "Components/ActorComponent.h"
@@ -12,6 +13,7 @@
 class AEODCharacterBase;
 class UGameplaySkillBase;
 class UGameplayEffectBase;
+struct FAttackInfo;
 
 UCLASS( ClassGroup=(Custom), meta=(BlueprintSpawnableComponent) )
 class EOD_API UGameplaySkillsComponent : public UActorComponent
@@ -77,6 +79,9 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Skill System")
 	UGameplaySkillBase* GetSkillForSkillGroup(FName SkillGroup) const;
 
+	/** Fills OutAttackInfo with the attack info of the skill corresponding to given SkillGroup. Returns false if there is no such skill or it has no attack info */
+	virtual bool GetAttackInfo(FName SkillGroup, int32 CollisionIndex, FAttackInfo& OutAttackInfo);
+
 	/** Event called when a skill gets cancelled */
 	UFUNCTION(BlueprintCallable, Category = "Skill System")
 	virtual void OnSkillCancelled(uint8 SkillIndex, FName SkillGroup, UGameplaySkillBase* Skill);
@@ -92,7 +97,11 @@ public:
 
 	inline FGameplaySkillTableRow* GetGameplaySkillTableRow(FName SkillID, const FString& ContextString = FString("AEODCharacterBase::GetSkill(), character skill lookup")) const;
 
-	inline const TMap<uint8, UGameplaySkillBase*>& GetSkillsMap() const { return SkillIndexToSkillMap; }
+	/** Returns the skill at SkillIndex, or nullptr if there is no skill at SkillIndex */
+	FORCEINLINE UGameplaySkillBase* GetSkill(uint8 SkillIndex) const { return Skills.IsValidIndex(SkillIndex) ? Skills[SkillIndex] : nullptr; }
+
+	/** Returns all skills indexed by their skill index. Index 0 is not a valid skill index and is always null */
+	FORCEINLINE const TArray<UGameplaySkillBase*>& GetSkills() const { return Skills; }
 
 	FORCEINLINE FName GetActivePrecedingChainSkillGroup() const { return ActivePrecedingChainSkillGroup; }
 
@@ -113,16 +122,17 @@ protected:
 	UPROPERTY(Transient)
 	TArray<UGameplaySkillBase*> ActiveSkills;
 
-	/** Skill index to skil map. Skill index will be used during replication */
+	/** Skills indexed by their skill index. Skill index will be used during replication */
 	UPROPERTY(Transient)
-	TMap<uint8, UGameplaySkillBase*> SkillIndexToSkillMap;
-
-	UPROPERTY(Transient)
-	TMap<FName, UGameplaySkillBase*> SkillGroupToSkillMap;
+	TArray<UGameplaySkillBase*> Skills;
 
+	/** Skill index of every skill group */
 	UPROPERTY(Transient)
 	TMap<FName, uint8> SkillGroupToSkillIndexMap;
 
+	/** Adds Skill to the skill tables at its skill index */
+	void AddSkill(UGameplaySkillBase* Skill);
+
 	UPROPERTY(Transient)
 	TArray<UGameplayEffectBase*> ActiveGameplayEffects;
 
@@ -184,6 +194,22 @@ public:
 
 	virtual void UpdateSkillCooldown(uint8 SkillIndex, float RemainingCooldown);
 
+	// --------------------------------------
+	//  Cooldowns
+	// --------------------------------------
+
+	/** Puts the skill at SkillIndex in cooldown for Duration seconds */
+	void StartSkillCooldown(uint8 SkillIndex, float Duration);
+
+	/** Ends the cooldown of the skill at SkillIndex before it expires */
+	void CancelSkillCooldown(uint8 SkillIndex);
+
+	/** Returns true if the skill at SkillIndex is in cooldown */
+	bool IsSkillInCooldown(uint8 SkillIndex) const;
+
+	/** Returns the cooldown time remaining in seconds for the skill at SkillIndex */
+	float GetRemainingCooldown(uint8 SkillIndex) const;
+
 	UFUNCTION(BlueprintCallable, Category = "Gameplay Effects")
 	virtual void AddGameplayEffect(UGameplayEffectBase* GameplayEffect);
 
@@ -203,12 +229,28 @@ public:
 
 	virtual bool IsGameplayEffectTypeActive(TSubclassOf<UGameplayEffectBase> GameplayEffectClass, UGameplayEffectBase* GameplayEffectToIgnore = nullptr);
 
+protected:
+
+	/** Event called when the cooldown of the skill at SkillIndex expires or gets cancelled */
+	virtual void OnSkillCooldownFinished(uint8 SkillIndex);
+
 private:
 
 	/** Cached pointer to EOD character owner */
 	UPROPERTY(Transient)
 	AEODCharacterBase* EODCharacterOwner;
 
+	/** Cooldowns of all skills of this component */
+	FSkillCooldownTable SkillCooldowns;
+
+	/** A single timer that fires when the next cooldown in SkillCooldowns expires */
+	FTimerHandle CooldownTimerHandle;
+
+	/** Sets CooldownTimerHandle to fire when the next cooldown expires */
+	void ScheduleNextCooldownExpiry();
+
+	void OnCooldownTimerExpired();
+
 protected:
 
 	// --------------------------------------
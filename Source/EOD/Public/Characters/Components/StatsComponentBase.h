@@ -5,9 +5,14 @@
 #include "CoreMinimal.h"
 #include "CombatLibrary.h"
 #include "Engine/Engine.h"
+#include "Engine/NetSerialization.h"
+#include "UObject/CoreNetTypes.h"
+#include "Containers/ArrayView.h"
 #include "Components/ActorComponent.h"
 #include "StatsComponentBase.generated.h"
 
+class ARegenerationManager;
+
 
 /**
  * Delegate for when the primary stat value changes
@@ -78,6 +83,101 @@ struct EOD_API FStatModifier
 	}
 };
 
+/**
+ * Modifiers of a single stat, stored as unsorted parallel arrays with a map from the unique ID of the modifier source to its slot.
+ * Removing a modifier moves the last one into its slot, so adding and removing modifiers never shifts the arrays.
+ * The sums of flat and percent modifiers are kept up to date as modifiers are added and removed,
+ * so applying modifiers to a stat never has to iterate them.
+ */
+struct EOD_API FStatModifierStore
+{
+public:
+
+	FStatModifierStore()
+	{
+		Sums[(uint8)EStatModType::Flat] = 0.f;
+		Sums[(uint8)EStatModType::Percent] = 0.f;
+	}
+
+	/** Adds the modifier from SourceID, or replaces the existing one. Returns false if an identical modifier already existed */
+	bool Set(uint32 SourceID, const FStatModifier& Modifier)
+	{
+		const int32* ExistingIndex = SourceIndices.Find(SourceID);
+		if (ExistingIndex)
+		{
+			const int32 Index = *ExistingIndex;
+			if (Values[Index] == Modifier.Value && ModTypes[Index] == Modifier.ModType)
+			{
+				return false;
+			}
+
+			Sums[(uint8)ModTypes[Index]] -= Values[Index];
+			Values[Index] = Modifier.Value;
+			ModTypes[Index] = Modifier.ModType;
+		}
+		else
+		{
+			SourceIndices.Add(SourceID, SourceIDs.Add(SourceID));
+			Values.Add(Modifier.Value);
+			ModTypes.Add(Modifier.ModType);
+		}
+
+		Sums[(uint8)Modifier.ModType] += Modifier.Value;
+		return true;
+	}
+
+	/** Removes the modifier from SourceID. Returns false if there was no modifier from it */
+	bool Remove(uint32 SourceID)
+	{
+		int32 Index = INDEX_NONE;
+		if (!SourceIndices.RemoveAndCopyValue(SourceID, Index))
+		{
+			return false;
+		}
+
+		Sums[(uint8)ModTypes[Index]] -= Values[Index];
+		SourceIDs.RemoveAtSwap(Index, 1, false);
+		Values.RemoveAtSwap(Index, 1, false);
+		ModTypes.RemoveAtSwap(Index, 1, false);
+
+		// The last modifier has been moved into the removed modifier's slot
+		if (SourceIDs.IsValidIndex(Index))
+		{
+			SourceIndices[SourceIDs[Index]] = Index;
+		}
+
+		// Don't let floating point error of the running sums outlive the modifiers
+		if (SourceIDs.Num() == 0)
+		{
+			Sums[(uint8)EStatModType::Flat] = 0.f;
+			Sums[(uint8)EStatModType::Percent] = 0.f;
+		}
+		return true;
+	}
+
+	FORCEINLINE float GetFlatSum() const { return Sums[(uint8)EStatModType::Flat]; }
+
+	FORCEINLINE float GetPercentSum() const { return Sums[(uint8)EStatModType::Percent]; }
+
+	FORCEINLINE int32 Num() const { return SourceIDs.Num(); }
+
+private:
+
+	/** Index of the modifier from each source in the arrays below */
+	TMap<uint32, int32> SourceIndices;
+
+	/** Unique IDs of the modifier sources */
+	TArray<uint32> SourceIDs;
+
+	TArray<float> Values;
+
+	TArray<EStatModType> ModTypes;
+
+	/** Sum of the values of all modifiers, indexed by EStatModType */
+	float Sums[2];
+
+};
+
 USTRUCT(BlueprintType)
 struct EOD_API FPrimaryStat
 {
@@ -90,11 +190,20 @@ public:
 	FPrimaryStat() :
 		MaxValue_NoMod(1),
 		MaxValue(1),
-		CurrentValue(0)
+		CurrentValue(0),
+		bDeferUpdates(false),
+		bRecalculationPending(false),
+		bBroadcastPending(false)
 	{
 	}
 
-	FPrimaryStat(int32 InMaxValue, int32 InCurrentValue)
+	FPrimaryStat(int32 InMaxValue, int32 InCurrentValue) :
+		MaxValue_NoMod(0),
+		MaxValue(1),
+		CurrentValue(0),
+		bDeferUpdates(false),
+		bRecalculationPending(false),
+		bBroadcastPending(false)
 	{
 		SetMaxValue(InMaxValue);
 		SetCurrentValue(InCurrentValue);
@@ -110,7 +219,7 @@ public:
 		{
 			MaxValue_NoMod = InValue;
 			RecalculateMaxValue();
-			OnStatValueChanged.Broadcast(MaxValue, CurrentValue);
+			BroadcastChange();
 		}
 	}
 
@@ -140,11 +249,18 @@ public:
 
 	void SetCurrentValue(int32 InValue)
 	{
+		// The current value is clamped to the max value, so it has to include any deferred modifier changes
+		if (bRecalculationPending)
+		{
+			RecalculateMaxValue();
+		}
+
 		int32 Max = GetMaxValue();
 		CurrentValue = InValue <= 0 ? 0 : InValue >= Max ? Max : InValue;
-		OnStatValueChanged.Broadcast(Max, CurrentValue);
+		BroadcastChange();
 	}
 
+	/** Returns the max value. Inside a stat transaction this doesn't include modifiers changed during the transaction */
 	int32 GetMaxValue() const { return MaxValue; }
 
 	int32 GetCurrentValue() const { return CurrentValue; }
@@ -154,17 +270,16 @@ public:
 	{
 		if (SourceObj)
 		{
-			uint32 UniqueID = SourceObj->GetUniqueID();
-			if (Modifiers.Contains(UniqueID))
-			{
-				Modifiers[UniqueID] = NewMod;
-			}
-			else
-			{
-				Modifiers.Add(UniqueID, NewMod);
-			}
-			RecalculateMaxValue();
-			OnStatValueChanged.Broadcast(MaxValue, CurrentValue);
+			AddModifier(SourceObj->GetUniqueID(), NewMod);
+		}
+	}
+
+	/** Add a modifier from a source that isn't an object, e.g., an equipment slot. SourceID must not collide with object unique IDs */
+	void AddModifier(uint32 SourceID, const FStatModifier& NewMod)
+	{
+		if (Modifiers.Set(SourceID, NewMod))
+		{
+			OnModifiersChanged();
 		}
 	}
 
@@ -173,47 +288,90 @@ public:
 	{
 		if (SourceObj)
 		{
-			uint32 UniqueID = SourceObj->GetUniqueID();
-			if (Modifiers.Contains(UniqueID))
-			{
-				Modifiers.Remove(UniqueID);
-				RecalculateMaxValue();
-				OnStatValueChanged.Broadcast(MaxValue, CurrentValue);
-			}
+			RemoveModifier(SourceObj->GetUniqueID());
+		}
+	}
+
+	void RemoveModifier(uint32 SourceID)
+	{
+		if (Modifiers.Remove(SourceID))
+		{
+			OnModifiersChanged();
 		}
 	}
 
 	void ForceBroadcastDelegate()
 	{
-		int32 CV = GetCurrentValue();
-		int32 MV = GetMaxValue();
-		OnStatValueChanged.Broadcast(MV, CV);
+		BroadcastChange();
+	}
+
+	/** Sets the final values received from server. Modifiers are server only, so the values are used as they are */
+	void SetReplicatedValues(int32 InMaxValue, int32 InCurrentValue)
+	{
+		if (MaxValue != InMaxValue || CurrentValue != InCurrentValue)
+		{
+			MaxValue = InMaxValue;
+			CurrentValue = InCurrentValue;
+			BroadcastChange();
+		}
+	}
+
+	/** Defers recalculation on modifier changes and all broadcasts until EndDeferredUpdates. Used by stat transactions */
+	void BeginDeferredUpdates()
+	{
+		bDeferUpdates = true;
+	}
+
+	/** Applies the deferred recalculation and broadcasts a single change with the final values, if anything changed */
+	void EndDeferredUpdates()
+	{
+		bDeferUpdates = false;
+		if (bRecalculationPending)
+		{
+			RecalculateMaxValue();
+		}
+		if (bBroadcastPending)
+		{
+			bBroadcastPending = false;
+			OnStatValueChanged.Broadcast(MaxValue, CurrentValue);
+		}
 	}
 
 	FOnPrimaryStatChangedMCDelegate OnStatValueChanged;
 
 private:
 
-	int32 RecalculateMaxValue()
+	void OnModifiersChanged()
 	{
-		Modifiers.ValueSort([&](const FStatModifier& Mod1, const FStatModifier& Mod2) { return Mod1 < Mod2; });
-
-		int32 MaxFlat = MaxValue_NoMod;
-		float FlatPercent = 0.f;
+		if (bDeferUpdates)
+		{
+			bRecalculationPending = true;
+			bBroadcastPending = true;
+		}
+		else
+		{
+			RecalculateMaxValue();
+			OnStatValueChanged.Broadcast(MaxValue, CurrentValue);
+		}
+	}
 
-		for (const TPair<uint32, FStatModifier>& ModPair : Modifiers)
+	void BroadcastChange()
+	{
+		if (bDeferUpdates)
 		{
-			if (ModPair.Value.ModType == EStatModType::Flat)
-			{
-				MaxFlat += ModPair.Value.Value;
-			}
-			else if (ModPair.Value.ModType == EStatModType::Percent)
-			{
-				FlatPercent += ModPair.Value.Value;
-			}
+			bBroadcastPending = true;
 		}
+		else
+		{
+			OnStatValueChanged.Broadcast(MaxValue, CurrentValue);
+		}
+	}
 
-		MaxValue = MaxFlat + (MaxFlat * (FlatPercent / 100.f));
+	int32 RecalculateMaxValue()
+	{
+		bRecalculationPending = false;
+		int32 MaxFlat = MaxValue_NoMod + Modifiers.GetFlatSum();
+		MaxValue = MaxFlat + (MaxFlat * (Modifiers.GetPercentSum() / 100.f));
 		return MaxValue;
 	}
 
@@ -225,8 +383,13 @@ private:
 	UPROPERTY()
 	int32 CurrentValue;
 
-	UPROPERTY()
-	TMap<uint32, FStatModifier> Modifiers;
+	FStatModifierStore Modifiers;
+
+	uint8 bDeferUpdates : 1;
+
+	uint8 bRecalculationPending : 1;
+
+	uint8 bBroadcastPending : 1;
 };
 
 USTRUCT(BlueprintType)
@@ -240,11 +403,19 @@ public:
 
 	FGenericStat() :
 		Value_NoMod(0),
-		Value(0)
+		Value(0),
+		bDeferUpdates(false),
+		bRecalculationPending(false),
+		bBroadcastPending(false)
 	{
 	}
 
-	FGenericStat(float InValue)
+	FGenericStat(float InValue) :
+		Value_NoMod(0),
+		Value(0),
+		bDeferUpdates(false),
+		bRecalculationPending(false),
+		bBroadcastPending(false)
 	{
 		SetValue(InValue);
 	}
@@ -259,28 +430,28 @@ public:
 		{
 			Value_NoMod = InValue;
 			RecalculateValue();
-			OnStatValueChanged.Broadcast(Value);
+			BroadcastChange();
 		}
 	}
 
-	float GetValue() { return Value; }
+	/** Returns the value. Inside a stat transaction this doesn't include modifiers changed during the transaction */
+	float GetValue() const { return Value; }
 
 	/** Add a modifier to the maximum value of this primary stat */
 	void AddModifier(UObject const* const SourceObj, const FStatModifier& NewMod)
 	{
 		if (SourceObj)
 		{
-			uint32 UniqueID = SourceObj->GetUniqueID();
-			if (Modifiers.Contains(UniqueID))
-			{
-				Modifiers[UniqueID] = NewMod;
-			}
-			else
-			{
-				Modifiers.Add(UniqueID, NewMod);
-			}
-			RecalculateValue();
-			OnStatValueChanged.Broadcast(Value);
+			AddModifier(SourceObj->GetUniqueID(), NewMod);
+		}
+	}
+
+	/** Add a modifier from a source that isn't an object, e.g., an equipment slot. SourceID must not collide with object unique IDs */
+	void AddModifier(uint32 SourceID, const FStatModifier& NewMod)
+	{
+		if (Modifiers.Set(SourceID, NewMod))
+		{
+			OnModifiersChanged();
 		}
 	}
 
@@ -289,46 +460,89 @@ public:
 	{
 		if (SourceObj)
 		{
-			uint32 UniqueID = SourceObj->GetUniqueID();
-			if (Modifiers.Contains(UniqueID))
-			{
-				Modifiers.Remove(UniqueID);
-				RecalculateValue();
-				OnStatValueChanged.Broadcast(Value);
-			}
+			RemoveModifier(SourceObj->GetUniqueID());
+		}
+	}
+
+	void RemoveModifier(uint32 SourceID)
+	{
+		if (Modifiers.Remove(SourceID))
+		{
+			OnModifiersChanged();
 		}
 	}
 
 	void ForceBroadcastDelegate()
 	{
-		float CV = GetValue();
-		OnStatValueChanged.Broadcast(CV);
+		BroadcastChange();
+	}
+
+	/** Sets the final value received from server. Modifiers are server only, so the value is used as it is */
+	void SetReplicatedValue(float InValue)
+	{
+		if (Value != InValue)
+		{
+			Value = InValue;
+			BroadcastChange();
+		}
+	}
+
+	/** Defers recalculation on modifier changes and all broadcasts until EndDeferredUpdates. Used by stat transactions */
+	void BeginDeferredUpdates()
+	{
+		bDeferUpdates = true;
+	}
+
+	/** Applies the deferred recalculation and broadcasts a single change with the final value, if anything changed */
+	void EndDeferredUpdates()
+	{
+		bDeferUpdates = false;
+		if (bRecalculationPending)
+		{
+			RecalculateValue();
+		}
+		if (bBroadcastPending)
+		{
+			bBroadcastPending = false;
+			OnStatValueChanged.Broadcast(Value);
+		}
 	}
 
 	FOnGenericStatChangedMCDelegate OnStatValueChanged;
 
 private:
 
-	float RecalculateValue()
+	void OnModifiersChanged()
 	{
-		Modifiers.ValueSort([&](const FStatModifier& Mod1, const FStatModifier& Mod2) { return Mod1 < Mod2; });
-
-		int32 MaxFlat = Value_NoMod;
-		float FlatPercent = 0.f;
+		if (bDeferUpdates)
+		{
+			bRecalculationPending = true;
+			bBroadcastPending = true;
+		}
+		else
+		{
+			RecalculateValue();
+			OnStatValueChanged.Broadcast(Value);
+		}
+	}
 
-		for (const TPair<uint32, FStatModifier>& ModPair : Modifiers)
+	void BroadcastChange()
+	{
+		if (bDeferUpdates)
 		{
-			if (ModPair.Value.ModType == EStatModType::Flat)
-			{
-				MaxFlat += ModPair.Value.Value;
-			}
-			else if (ModPair.Value.ModType == EStatModType::Percent)
-			{
-				FlatPercent += ModPair.Value.Value;
-			}
+			bBroadcastPending = true;
+		}
+		else
+		{
+			OnStatValueChanged.Broadcast(Value);
 		}
+	}
 
-		Value = MaxFlat + (MaxFlat * (FlatPercent / 100.f));
+	float RecalculateValue()
+	{
+		bRecalculationPending = false;
+		float Flat = Value_NoMod + Modifiers.GetFlatSum();
+		Value = Flat + (Flat * (Modifiers.GetPercentSum() / 100.f));
 		return Value;
 	}
 
@@ -337,8 +551,13 @@ private:
 	UPROPERTY()
 	float Value;
 
-	UPROPERTY()
-	TMap<uint32, FStatModifier> Modifiers;
+	FStatModifierStore Modifiers;
+
+	uint8 bDeferUpdates : 1;
+
+	uint8 bRecalculationPending : 1;
+
+	uint8 bBroadcastPending : 1;
 
 };
 
@@ -400,6 +619,11 @@ public:
 	}
 };
 
+/**
+ * Crowd control immunities of a character, stored as a bitmask indexed by ECrowdControlEffect.
+ * The final mask is cached and maintained incrementally from per bit reference counts of the modifiers,
+ * so checking an immunity is a single bit test and adding or removing a modifier never re-evaluates the other modifiers.
+ */
 USTRUCT(BlueprintType)
 struct EOD_API FCCImmunities
 {
@@ -411,11 +635,16 @@ public:
 
 	FCCImmunities() :
 		Value_NoMod(0),
-		Value(0)
+		Value(0),
+		AdditiveMask(0),
+		ReductiveMask(0)
 	{
+		FMemory::Memzero(AdditiveRefCounts);
+		FMemory::Memzero(ReductiveRefCounts);
 	}
 
-	FCCImmunities(float InValue)
+	FCCImmunities(float InValue) :
+		FCCImmunities()
 	{
 		SetValue(InValue);
 	}
@@ -425,112 +654,306 @@ public:
 	/** Directly set the value that doesn't have any modifier applied */
 	void SetValue(float InValue)
 	{
-		Value_NoMod = InValue;
+		Value_NoMod = (uint8)InValue;
+		UpdateValue();
 	}
 
-	float GetValue() { return Value; }
+	float GetValue() const { return Value; }
 
-	/** Add a modifier to the maximum value of this primary stat */
+	/** Returns the final immunities as a bitmask indexed by ECrowdControlEffect */
+	FORCEINLINE uint8 GetImmunityMask() const { return Value; }
+
+	/** Add a modifier to the immunities. Replaces the previous modifier of SourceObj */
 	void AddModifier(UObject const* const SourceObj, const FCCImmunityModifier& NewMod)
 	{
 		if (SourceObj)
 		{
-			uint32 UniqueID = SourceObj->GetUniqueID();
-			if (Modifiers.Contains(UniqueID))
-			{
-				Modifiers[UniqueID] = NewMod;
-			}
-			else
-			{
-				Modifiers.Add(UniqueID, NewMod);
-			}
-			RecalculateValue();
+			FCCImmunityModifier& Mod = Modifiers.FindOrAdd(SourceObj->GetUniqueID());
+			ApplyModifier(Mod, -1);
+			Mod = NewMod;
+			ApplyModifier(Mod, 1);
+			UpdateValue();
 		}
 	}
 
-	/** Remove a modifier from the maximum value of this primary stat */
+	/** Remove the modifier of SourceObj from the immunities */
 	void RemoveModifier(UObject const* const SourceObj)
 	{
-		if (SourceObj)
+		FCCImmunityModifier Mod;
+		if (SourceObj && Modifiers.RemoveAndCopyValue(SourceObj->GetUniqueID(), Mod))
 		{
-			uint32 UniqueID = SourceObj->GetUniqueID();
-			if (Modifiers.Contains(UniqueID))
-			{
-				Modifiers.Remove(UniqueID);
-				RecalculateValue();
-			}
+			ApplyModifier(Mod, -1);
+			UpdateValue();
 		}
 	}
 
-	bool HasCCImmunity(ECrowdControlEffect CCImmunity) const
+	/** Sets the final immunities received from server. Modifiers are server only, so the value is used as it is */
+	void SetReplicatedValue(uint8 InValue)
 	{
-		return (Value & (1 << (uint8)CCImmunity));
+		Value = InValue;
 	}
 
-	bool HasCCImmunities(uint8 CCImmunities) const
+	FORCEINLINE bool HasCCImmunity(ECrowdControlEffect CCImmunity) const
+	{
+		return IsImmune(Value, CCImmunity);
+	}
+
+	FORCEINLINE bool HasCCImmunities(uint8 CCImmunities) const
 	{
 		return (Value & CCImmunities) == CCImmunities;
 	}
 
+	/** Returns true if ImmunityMask contains the immunity to CCE */
+	FORCEINLINE static bool IsImmune(uint8 ImmunityMask, ECrowdControlEffect CCE)
+	{
+		return (ImmunityMask & (1 << (uint8)CCE)) != 0;
+	}
+
+	/**
+	 * Returns true if CCE of an attack can be applied to a target with the given immunities and state.
+	 * This is the only place the rule lives, so that live combat and combat replays always agree on it.
+	 */
+	FORCEINLINE static bool CanApplyCCE(uint8 ImmunityMask, ECrowdControlEffect CCE, bool bAttackBlocked, bool bTargetDead)
+	{
+		return !bAttackBlocked && !bTargetDead && !IsImmune(ImmunityMask, CCE);
+	}
+
 private:
 
-	float RecalculateValue()
+	/** Adds Delta to the reference counts of the immunities in Mod, and updates the masks of immunities that are referenced at least once */
+	void ApplyModifier(const FCCImmunityModifier& Mod, int32 Delta)
 	{
-		Modifiers.ValueSort([&](const FCCImmunityModifier& Mod1, const FCCImmunityModifier& Mod2) { return Mod1 < Mod2; });
+		uint16* RefCounts = Mod.ModType == ECCImmunityModType::Reductive ? ReductiveRefCounts : AdditiveRefCounts;
+		uint8& Mask = Mod.ModType == ECCImmunityModType::Reductive ? ReductiveMask : AdditiveMask;
 
-		Value = Value_NoMod;
-		for (const TPair<uint32, FCCImmunityModifier>& ModPair : Modifiers)
+		for (uint32 Bits = Mod.Value; Bits != 0; Bits &= Bits - 1)
 		{
-			if (ModPair.Value.ModType == ECCImmunityModType::Additive)
+			const uint32 Bit = FMath::CountTrailingZeros(Bits);
+			RefCounts[Bit] = (uint16)(RefCounts[Bit] + Delta);
+			if (RefCounts[Bit] > 0)
 			{
-				AddImmunities(ModPair.Value.Value);
+				Mask |= (1 << Bit);
 			}
-			else if (ModPair.Value.ModType == ECCImmunityModType::Reductive)
+			else
 			{
-				RemoveImmunities(ModPair.Value.Value);
+				Mask &= ~(1 << Bit);
 			}
 		}
-
-		return Value;
 	}
 
-	void AddImmunity(ECrowdControlEffect CCImmunity)
+	/** Reductive modifiers take precedence over the base value and additive modifiers */
+	FORCEINLINE void UpdateValue()
 	{
-		Value |= (1 << (uint8)CCImmunity);
+		Value = (Value_NoMod | AdditiveMask) & ~ReductiveMask;
 	}
 
-	void AddImmunities(uint8 CCImmunities)
-	{
-		Value |= CCImmunities;
-	}
+private:
 
-	void RemoveImmunity(ECrowdControlEffect CCImmunity)
-	{
-		Value ^= (1 << (uint8)CCImmunity);
-	}
+	uint8 Value_NoMod;
+
+	UPROPERTY()
+	uint8 Value;
 
-	void RemoveImmunities(uint8 CCImmunities)
+	UPROPERTY()
+	TMap<uint32, FCCImmunityModifier> Modifiers;
+
+	/** Immunities added by at least one additive modifier */
+	uint8 AdditiveMask;
+
+	/** Immunities removed by at least one reductive modifier */
+	uint8 ReductiveMask;
+
+	/** Number of additive modifiers adding each immunity */
+	uint16 AdditiveRefCounts[8];
+
+	/** Number of reductive modifiers removing each immunity */
+	uint16 ReductiveRefCounts[8];
+
+};
+
+/** Identifiers of the primary and generic stats of UStatsComponentBase. Primary stats come first */
+UENUM(BlueprintType)
+enum class EStatId : uint8
+{
+	Health,
+	Mana,
+	Stamina,
+	HealthRegenRate,
+	ManaRegenRate,
+	StaminaRegenRate,
+	PhysicalAttack,
+	MagickalAttack,
+	PhysicalResistance,
+	MagickalResistance,
+	PhysicalCritRate,
+	MagickalCritRate,
+	PhysicalCritBonus,
+	MagickalCritBonus,
+	BleedResistance,
+	CrowdControlResistance,
+	CooldownModifier,
+	ExpModifier,
+	SpellCastingSpeedModifier,
+	StaminaConsumptionModifier,
+	PhysicalDamageReductionOnBlock,
+	MagickalDamageReductionOnBlock,
+	Darkness,
+	Num UMETA(Hidden)
+};
+
+enum class EStatType : uint8
+{
+	/** FPrimaryStat, with a max and a current value */
+	Primary,
+	/** FGenericStat */
+	Generic
+};
+
+/** Compile time description of a stat */
+struct FStatInfo
+{
+	const TCHAR* Name;
+
+	EStatType Type;
+
+	/** Base values set through UStatsComponentBase::SetStatBaseValue are clamped to [MinBaseValue, MaxBaseValue] */
+	float MinBaseValue;
+
+	float MaxBaseValue;
+
+	/** Determines which connections receive the final value of this stat */
+	ELifetimeCondition ReplicationCondition;
+};
+
+/** Descriptions of all stats, indexed by EStatId */
+constexpr FStatInfo StatInfos[] =
+{
+	{ TEXT("Health"),							EStatType::Primary,	1.f,	MAX_flt,	COND_None },
+	{ TEXT("Mana"),								EStatType::Primary,	1.f,	MAX_flt,	COND_None },
+	{ TEXT("Stamina"),							EStatType::Primary,	1.f,	MAX_flt,	COND_None },
+	{ TEXT("HealthRegenRate"),					EStatType::Generic,	0.f,	MAX_flt,	COND_OwnerOnly },
+	{ TEXT("ManaRegenRate"),					EStatType::Generic,	0.f,	MAX_flt,	COND_OwnerOnly },
+	{ TEXT("StaminaRegenRate"),					EStatType::Generic,	0.f,	MAX_flt,	COND_OwnerOnly },
+	{ TEXT("PhysicalAttack"),					EStatType::Generic,	0.f,	MAX_flt,	COND_None },
+	{ TEXT("MagickalAttack"),					EStatType::Generic,	0.f,	MAX_flt,	COND_None },
+	{ TEXT("PhysicalResistance"),				EStatType::Generic,	0.f,	MAX_flt,	COND_None },
+	{ TEXT("MagickalResistance"),				EStatType::Generic,	0.f,	MAX_flt,	COND_None },
+	{ TEXT("PhysicalCritRate"),					EStatType::Generic,	0.f,	100.f,		COND_None },
+	{ TEXT("MagickalCritRate"),					EStatType::Generic,	0.f,	100.f,		COND_None },
+	{ TEXT("PhysicalCritBonus"),				EStatType::Generic,	0.f,	MAX_flt,	COND_None },
+	{ TEXT("MagickalCritBonus"),				EStatType::Generic,	0.f,	MAX_flt,	COND_None },
+	{ TEXT("BleedResistance"),					EStatType::Generic,	0.f,	100.f,		COND_None },
+	{ TEXT("CrowdControlResistance"),			EStatType::Generic,	0.f,	100.f,		COND_None },
+	{ TEXT("CooldownModifier"),					EStatType::Generic,	0.f,	MAX_flt,	COND_None },
+	{ TEXT("ExpModifier"),						EStatType::Generic,	0.f,	MAX_flt,	COND_None },
+	{ TEXT("SpellCastingSpeedModifier"),		EStatType::Generic,	0.f,	MAX_flt,	COND_None },
+	{ TEXT("StaminaConsumptionModifier"),		EStatType::Generic,	0.f,	MAX_flt,	COND_None },
+	{ TEXT("PhysicalDamageReductionOnBlock"),	EStatType::Generic,	0.f,	100.f,		COND_None },
+	{ TEXT("MagickalDamageReductionOnBlock"),	EStatType::Generic,	0.f,	100.f,		COND_None },
+	{ TEXT("Darkness"),							EStatType::Generic,	0.f,	MAX_flt,	COND_None },
+};
+
+static_assert(ARRAY_COUNT(StatInfos) == (uint8)EStatId::Num, "Every stat needs an entry in StatInfos");
+
+constexpr const FStatInfo& GetStatInfo(EStatId StatId)
+{
+	return StatInfos[(uint8)StatId];
+}
+
+/** Returns the stat named StatName in StatInfos, or EStatId::Num if there is no such stat */
+EOD_API EStatId FindStatIdByName(FName StatName);
+
+/** A modifier to apply to the stat StatId, e.g., a single stat bonus of an equipment */
+struct FStatModifierEntry
+{
+	EStatId StatId;
+
+	FStatModifier Modifier;
+
+	FStatModifierEntry(EStatId InStatId, const FStatModifier& InModifier) :
+		StatId(InStatId),
+		Modifier(InModifier)
 	{
-		Value ^= CCImmunities;
 	}
+};
 
-	void RemoveAllImmunities()
+/** Modifiers of a single source, e.g., an equipment */
+typedef TArray<FStatModifierEntry, TInlineAllocator<16>> FStatModifierEntries;
+
+/**
+ * Plain copy of the final values of all stats of a stats component, e.g., for combat logs and damage calculations.
+ * Capturing a snapshot doesn't broadcast anything and the snapshot can be copied around freely.
+ */
+struct EOD_API FStatsSnapshot
+{
+	/** Final value of every stat, indexed by EStatId. This is the max value for primary stats */
+	float Values[(uint8)EStatId::Num];
+
+	/** Current value of every stat, indexed by EStatId. Only differs from Values for primary stats */
+	float CurrentValues[(uint8)EStatId::Num];
+
+	/** Bitmask of ECrowdControlEffect immunities */
+	uint8 CCImmunities;
+
+	/** Bit of the CC immunities in the mask returned by Diff */
+	static const uint32 CCImmunitiesDiffBit = 1u << (uint8)EStatId::Num;
+
+	FORCEINLINE float GetValue(EStatId StatId) const { return Values[(uint8)StatId]; }
+
+	FORCEINLINE float GetCurrentValue(EStatId StatId) const { return CurrentValues[(uint8)StatId]; }
+
+	/** Returns a bitmask of the stats, indexed by EStatId, that differ between this and Other. Changed CC immunities set CCImmunitiesDiffBit */
+	uint32 Diff(const FStatsSnapshot& Other) const;
+
+	/** Returns the changes from this to Other as a readable string, e.g., "PhysicalAttack: 10.00 -> 12.50" for each changed stat */
+	FString DiffToString(const FStatsSnapshot& Other) const;
+
+};
+
+/**
+ * Final values of a set of stats, quantized to integers, that replicate as a single property.
+ * Each connection only receives the values that changed since the last state it was sent, along with a bitmask of the changed values.
+ */
+USTRUCT()
+struct EOD_API FStatsReplicationBlock
+{
+	GENERATED_USTRUCT_BODY()
+
+public:
+
+	FORCEINLINE void SetNum(int32 Num)
 	{
-		Value = 0;
+		QuantizedValues.SetNumZeroed(Num);
 	}
 
-private:
+	FORCEINLINE int32 Num() const { return QuantizedValues.Num(); }
 
-	uint8 Value_NoMod;
+	FORCEINLINE void SetInt(int32 Index, int32 InValue) { QuantizedValues[Index] = InValue; }
 
-	UPROPERTY()
-	uint8 Value;
+	FORCEINLINE int32 GetInt(int32 Index) const { return QuantizedValues[Index]; }
 
-	UPROPERTY()
-	TMap<uint32, FCCImmunityModifier> Modifiers;
+	/** Float values replicate with a precision of two decimal places */
+	FORCEINLINE void SetFloat(int32 Index, float InValue) { QuantizedValues[Index] = FMath::RoundToInt(InValue * 100.f); }
+
+	FORCEINLINE float GetFloat(int32 Index) const { return QuantizedValues[Index] / 100.f; }
+
+	bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms);
+
+private:
+
+	TArray<int32> QuantizedValues;
 
 };
 
+template<>
+struct TStructOpsTypeTraits<FStatsReplicationBlock> : public TStructOpsTypeTraitsBase2<FStatsReplicationBlock>
+{
+	enum
+	{
+		WithNetDeltaSerializer = true,
+	};
+};
+
 
 /**
  * An abstract base class that lays out the expected behavior of stats component to manage character stats.
@@ -552,22 +975,76 @@ public:
 	/** Sets up property replication */
 	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
 
+	/** Packs the final stat values into the replicated stat blocks */
+	virtual void PreReplication(IRepChangedPropertyTracker& ChangedPropertyTracker) override;
+
 	virtual void BeginPlay() override;
 
+	/** Stops any regeneration of this component */
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 	/** Dummy declaration. This component doesn't tick */
 	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
 
+	// --------------------------------------
+	//  Stat Transactions
+	// --------------------------------------
+
+	/**
+	 * Starts a stat transaction. Until the transaction is committed, stats are not recalculated when their modifiers change,
+	 * and each stat broadcasts at most one change, with its final values, on commit.
+	 * Transactions can be nested, only the outermost commit applies the changes.
+	 */
+	void BeginStatTransaction();
+
+	void CommitStatTransaction();
+
+	FORCEINLINE bool IsInStatTransaction() const { return StatTransactionDepth > 0; }
+
+	// --------------------------------------
+	//  Stats by Identifier
+	// --------------------------------------
+
+	/** Returns the primary stat StatId, or null if StatId is not a primary stat */
+	FPrimaryStat* GetPrimaryStat(EStatId StatId);
+
+	/** Returns the generic stat StatId, or null if StatId is not a generic stat */
+	FGenericStat* GetGenericStat(EStatId StatId);
+
+	/** Sets the value of StatId that doesn't have any modifier applied, clamped to the range in its FStatInfo. This is the max value for primary stats */
+	void SetStatBaseValue(EStatId StatId, float InValue);
+
+	/** Returns the final value of StatId. This is the max value for primary stats */
+	float GetStatValue(EStatId StatId);
+
+	void AddStatModifier(EStatId StatId, uint32 SourceID, const FStatModifier& Modifier);
+
+	void RemoveStatModifier(EStatId StatId, uint32 SourceID);
+
+	/** Adds all modifiers from SourceID in a single stat transaction */
+	void AddStatModifiers(uint32 SourceID, TArrayView<const FStatModifierEntry> ModifierEntries);
+
+	/** Removes the modifiers from SourceID from all stats in a single stat transaction */
+	void RemoveAllStatModifiers(uint32 SourceID);
+
+	// --------------------------------------
+	//  Stat Snapshots
+	// --------------------------------------
+
+	/** Returns the current final values of all stats. Inside a stat transaction this doesn't include modifiers changed during the transaction */
+	FStatsSnapshot CaptureSnapshot() const;
+
 	// --------------------------------------
 	//  Health, Mana, and Stamina
 	// --------------------------------------	
 
-	UPROPERTY(ReplicatedUsing = OnRep_Health)
+	UPROPERTY()
 	FPrimaryStat Health;
 
-	UPROPERTY(ReplicatedUsing = OnRep_Mana)
+	UPROPERTY()
 	FPrimaryStat Mana;
 	
-	UPROPERTY(ReplicatedUsing = OnRep_Stamina)
+	UPROPERTY()
 	FPrimaryStat Stamina;
 	
 	/** Percentage (0 to 1) of max health that will be considered low health */
@@ -591,13 +1068,13 @@ public:
 	// --------------------------------------
 
 	//~ @note If regeneration rates are not displayed to player in-game then they are not needed to be replicated
-	UPROPERTY(Replicated, EditDefaultsOnly, Category = BaseStats, AdvancedDisplay)
+	UPROPERTY(EditDefaultsOnly, Category = BaseStats, AdvancedDisplay)
 	FGenericStat HealthRegenRate;
 
-	UPROPERTY(Replicated, EditDefaultsOnly, Category = BaseStats, AdvancedDisplay)
+	UPROPERTY(EditDefaultsOnly, Category = BaseStats, AdvancedDisplay)
 	FGenericStat ManaRegenRate;
 
-	UPROPERTY(Replicated, EditDefaultsOnly, Category = BaseStats, AdvancedDisplay)
+	UPROPERTY(EditDefaultsOnly, Category = BaseStats, AdvancedDisplay)
 	FGenericStat StaminaRegenRate;
 	
 	/** Determines whether this character can regenerate health at all */
@@ -636,10 +1113,14 @@ public:
 	UPROPERTY(EditDefaultsOnly, Category = "Regeneration")
 	float StaminaRegenTickInterval;
 
+	//~ Regeneration timers are only used when there is no regeneration manager, e.g., on clients
 	FTimerHandle HealthRegenTimerHandle;
 	FTimerHandle ManaRegenTimerHandle;
 	FTimerHandle StaminaRegenTimerHandle;
 
+	/** Returns the regeneration manager of the current game mode. Null on clients */
+	ARegenerationManager* GetRegenerationManager() const;
+
 	/** Starts health regeneration on player. Automatically stops once the health is full or if manually stopped */
 	void ActivateHealthRegeneration();
 
@@ -666,28 +1147,28 @@ public:
 	//  Attack
 	// --------------------------------------
 
-	UPROPERTY(Replicated)
+	UPROPERTY()
 	FGenericStat PhysicalAttack;
 
-	UPROPERTY(Replicated)
+	UPROPERTY()
 	FGenericStat MagickalAttack;
 
-	UPROPERTY(Replicated)
+	UPROPERTY()
 	FGenericStat PhysicalResistance;
 
-	UPROPERTY(Replicated)
+	UPROPERTY()
 	FGenericStat MagickalResistance;
 
-	UPROPERTY(Replicated)
+	UPROPERTY()
 	FGenericStat PhysicalCritRate;
 
-	UPROPERTY(Replicated)
+	UPROPERTY()
 	FGenericStat MagickalCritRate;
 
-	UPROPERTY(Replicated)
+	UPROPERTY()
 	FGenericStat PhysicalCritBonus;
 
-	UPROPERTY(Replicated)
+	UPROPERTY()
 	FGenericStat MagickalCritBonus;
 
 	//~ @todo future
@@ -707,22 +1188,22 @@ public:
 	FSecondaryStat ElementalDarkDamage;
 	*/
 
-	UPROPERTY(Replicated)
+	UPROPERTY()
 	FGenericStat BleedResistance;
 
-	UPROPERTY(Replicated)
+	UPROPERTY()
 	FGenericStat CrowdControlResistance;
 
-	UPROPERTY(Replicated)
+	UPROPERTY()
 	FGenericStat CooldownModifier;
 
-	UPROPERTY(Replicated)
+	UPROPERTY()
 	FGenericStat ExpModifier;
 
-	UPROPERTY(Replicated)
+	UPROPERTY()
 	FGenericStat SpellCastingSpeedModifier;
 
-	UPROPERTY(Replicated)
+	UPROPERTY()
 	FGenericStat StaminaConsumptionModifier;
 
 	//~ @todo future
@@ -730,16 +1211,16 @@ public:
 	FStat_Float DropRateModifier;
 	*/
 
-	UPROPERTY(Replicated)
+	UPROPERTY()
 	FGenericStat PhysicalDamageReductionOnBlock;
 
-	UPROPERTY(Replicated)
+	UPROPERTY()
 	FGenericStat MagickalDamageReductionOnBlock;
 
-	UPROPERTY(Replicated)
+	UPROPERTY()
 	FCCImmunities CCImmunities;
 	
-	UPROPERTY(Replicated)
+	UPROPERTY()
 	FGenericStat Darkness;
 
 protected:
@@ -748,13 +1229,62 @@ protected:
 	//  Network
 	// --------------------------------------
 	
+	/**
+	 * Final values of the stats that are replicated to everyone. Stats themselves don't replicate,
+	 * so their modifiers stay on server.
+	 */
+	UPROPERTY(ReplicatedUsing = OnRep_ReplicatedStats)
+	FStatsReplicationBlock ReplicatedStats;
+
+	/** Final values of the stats that are only replicated to the owner */
+	UPROPERTY(ReplicatedUsing = OnRep_OwnerReplicatedStats)
+	FStatsReplicationBlock OwnerReplicatedStats;
+
 	UFUNCTION()
-	virtual void OnRep_Health();
-	
-	UFUNCTION()
-	virtual void OnRep_Mana();
-	
+	virtual void OnRep_ReplicatedStats();
+
 	UFUNCTION()
-	virtual void OnRep_Stamina();
+	virtual void OnRep_OwnerReplicatedStats();
+
+private:
+
+	/** Applies the values of the stat block that holds stats replicated with ReplicationCondition */
+	void OnRepStatBlock(ELifetimeCondition ReplicationCondition);
+
+	/** Calls PrimaryStatFunc on every FPrimaryStat and GenericStatFunc on every FGenericStat of this component */
+	template<typename PrimaryStatFuncType, typename GenericStatFuncType>
+	void ForEachStat(PrimaryStatFuncType PrimaryStatFunc, GenericStatFuncType GenericStatFunc);
+
+	/** Calls the functions on every stat in the order of EStatId, without allowing them to modify the stats */
+	template<typename PrimaryStatFuncType, typename GenericStatFuncType>
+	void ForEachStat(PrimaryStatFuncType PrimaryStatFunc, GenericStatFuncType GenericStatFunc) const;
+
+	int32 StatTransactionDepth;
+
+};
+
+/** Batches all stat changes made during the lifetime of this scope into a single stat transaction */
+struct FScopedStatTransaction
+{
+	FScopedStatTransaction(UStatsComponentBase* InStatsComp) :
+		StatsComp(InStatsComp)
+	{
+		if (StatsComp)
+		{
+			StatsComp->BeginStatTransaction();
+		}
+	}
+
+	~FScopedStatTransaction()
+	{
+		if (StatsComp)
+		{
+			StatsComp->CommitStatTransaction();
+		}
+	}
+
+private:
+
+	UStatsComponentBase* StatsComp;
 
 };
@@ -9,6 +9,7 @@
 #include "CharacterLibrary.h"
 #include "StatsComponentBase.h"
 #include "CombatInterface.h"
+#include "CharacterTransformHistory.h"
 
 #include "TimerManager.h"
 #include "Engine/World.h"
@@ -155,6 +156,9 @@ public:
 	/** Called when the game starts or when spawned */
 	virtual void BeginPlay() override;
 
+	/** Called when this character is being removed from the level */
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 	/** Updates character state every frame */
 	virtual void Tick(float DeltaTime) override;
 
@@ -444,22 +448,24 @@ public:
 
 	virtual AActor* GetInterfaceOwner() override;
 
-	virtual TSharedPtr<FAttackInfo> GetAttackInfoPtr(const FName& SkillGroup, const int32 CollisionIndex) override;
+	virtual bool GetAttackInfo(const FName& SkillGroup, const int32 CollisionIndex, FAttackInfo& OutAttackInfo) override;
 
 	/** [server] Receive an attack on server */
-	virtual TSharedPtr<FAttackResponse> ReceiveAttack(
+	virtual bool ReceiveAttack(
 		AActor* HitInstigator,
 		ICombatInterface* InstigatorCI,
-		const TSharedPtr<FAttackInfo>& AttackInfoPtr,
+		const FAttackInfo& AttackInfo,
 		const FHitResult& DirectHitResult,
 		const bool bLineHitResultFound,
-		const FHitResult& LineHitResult) override;
+		const FHitResult& LineHitResult,
+		FAttackResponse& OutAttackResponse,
+		const FDamageOutcome* PrecomputedDamage = nullptr) override;
 
 	/** Returns the actual damage received by this character */
 	virtual float GetActualDamage(
 		AActor* HitInstigator,
 		ICombatInterface* InstigatorCI,
-		const TSharedPtr<FAttackInfo>& AttackInfoPtr,
+		const FAttackInfo& AttackInfo,
 		const bool bCritHit,
 		const bool bAttackBlocked) override;
 
@@ -484,10 +490,28 @@ public:
 
 protected:
 
-	virtual TSharedPtr<FAttackInfo> GetAttackInfoPtrFromNormalAttack(const FString& NormalAttackStr);
+	/** Returns the attack info of a normal attack from NormalAttackInfoCache, calculating and caching it on a cache miss */
+	virtual bool GetAttackInfoFromNormalAttack(const FName& NormalAttackName, FAttackInfo& OutAttackInfo);
+	/** Calculates the attack info of a normal attack from its name and the current stats of this character */
+	virtual bool CalculateNormalAttackInfo(const FString& NormalAttackStr, FAttackInfo& OutAttackInfo);
 	virtual EWeaponType GetWeaponTypeFromNormalAttackString(const FString& NormalAttackStr);
 	virtual int32 GetAttackIndexFromNormalAttackString(const FString& NormalAttackStr);
 
+	/** Discards all cached normal attack infos. Called on weapon change and whenever a stat used by normal attacks changes */
+	void InvalidateNormalAttackInfoCache();
+
+	/** Binds (or unbinds) NormalAttackInfoCache invalidation to the stats that normal attacks depend on */
+	void BindNormalAttackStatDelegates(UStatsComponentBase* StatsComp);
+	void UnbindNormalAttackStatDelegates(UStatsComponentBase* StatsComp);
+
+	void OnNormalAttackStatChanged(float NewValue);
+
+	/** [server] Attack info of normal attacks, keyed by normal attack skill group */
+	TMap<FName, FAttackInfo> NormalAttackInfoCache;
+
+	/** [server] Recent world transforms of this character's mesh. Only recorded on networked servers */
+	FCharacterTransformHistory TransformHistory;
+
 	UPROPERTY(ReplicatedUsing = OnRep_LastReceivedHit)
 	FReceivedHitInfo LastReceivedHit;
 	
@@ -871,6 +895,19 @@ public:
 	/** Returns character faction */
 	FORCEINLINE EFaction GetFaction() const;
 
+	/**
+	 * Returns the mask of factions whose characters can never be damaged by this character.
+	 * Combat queries made by this character ignore bodies tagged with any of these faction bits.
+	 * Must never include a faction that IsEnemyOf could consider hostile.
+	 */
+	virtual FMaskFilter GetCombatIgnoreMask() const;
+
+	/** Tags the collision bodies of this character with its faction's mask filter bit */
+	void UpdateFactionMaskFilter();
+
+	/** [server] Returns the recent world transforms of this character's mesh, used to rewind it for lag compensation */
+	FORCEINLINE const FCharacterTransformHistory& GetTransformHistory() const { return TransformHistory; }
+
 	/** In game faction of your character */
 	UPROPERTY(EditDefaultsOnly, Category = RequiredInfo)
 	EFaction Faction;
@@ -998,59 +1035,69 @@ public:
 	//  Crowd Control Effects
 	// --------------------------------------
 
-	/** Returns true if character can flinch */
-	virtual bool CanFlinch() const;
+	/** Returns true if CCE of an attack can be applied to this character. This is the single immunity check used for every hit by ApplyCCE */
+	FORCEINLINE bool CanReceiveCCE(ECrowdControlEffect CCE, bool bAttackBlocked = false) const;
 
-	/** Returns true if character can stun */
-	virtual bool CanStun() const;
-
-	/** Returns true if character can get knocked down */
-	virtual bool CanKnockdown() const;
-
-	/** Returns true if character can get knocked back */
-	virtual bool CanKnockback() const;
-
-	/** Returns true if character can be frozed/crystalized */
-	virtual bool CanFreeze() const;
-
-	/** Returns true if character can be interrupted */
-	virtual bool CanInterrupt() const;
-
-	/** Flinch this character (visual feedback) */
+	/** Flinch this character (visual feedback) if it can receive flinch */
 	UFUNCTION(BlueprintCallable, Category = CrowdControlEffect, meta = (DisplayName = "CCE Flinch"))
-	virtual bool CCEFlinch(const float BCAngle);
+	bool CCEFlinch(const float BCAngle);
 
-	/** Interrupt this character's current action */
+	/** Interrupt this character's current action if it can be interrupted */
 	UFUNCTION(BlueprintCallable, Category = CrowdControlEffect, meta = (DisplayName = "CCE Interrupt"))
-	virtual bool CCEInterrupt(const float BCAngle);
+	bool CCEInterrupt(const float BCAngle);
 
-	/** Applies stun to this character */
+	/** Applies stun to this character if it can be stunned */
 	UFUNCTION(BlueprintCallable, Category = CrowdControlEffect, meta = (DisplayName = "CCE Stun"))
-	virtual bool CCEStun(const float Duration);
+	bool CCEStun(const float Duration);
 
 	/** Removes 'stun' crowd control effect from this character */
 	UFUNCTION(BlueprintCallable, Category = CrowdControlEffect, meta = (DisplayName = "CCE Remove Stun"))
 	virtual void CCERemoveStun();
 
-	/** Freeze this character */
+	/** Freeze this character if it can be frozen */
 	UFUNCTION(BlueprintCallable, Category = CrowdControlEffect, meta = (DisplayName = "CCE Freeze"))
-	virtual bool CCEFreeze(const float Duration);
+	bool CCEFreeze(const float Duration);
 
 	/** Removes 'freeze' crowd control effect from this character */
 	UFUNCTION(BlueprintCallable, Category = CrowdControlEffect, meta = (DisplayName = "CCE Unfreeze"))
 	virtual void CCEUnfreeze();
 
-	/** Knockdown this character */
+	/** Knockdown this character if it can be knocked down */
 	UFUNCTION(BlueprintCallable, Category = CrowdControlEffect, meta = (DisplayName = "CCE Knockdown"))
-	virtual bool CCEKnockdown(const float Duration);
+	bool CCEKnockdown(const float Duration);
 
 	/** Removes 'knock-down' crowd control effect from this character */
 	UFUNCTION(BlueprintCallable, Category = CrowdControlEffect, meta = (DisplayName = "CCE End Knockdown"))
 	virtual void CCEEndKnockdown();
 
-	/** Knockback this character */
+	/** Knockback this character if it can be knocked back */
 	UFUNCTION(BlueprintCallable, Category = CrowdControlEffect, meta = (DisplayName = "CCE Knockback"))
-	virtual bool CCEKnockback(const float Duration, const FVector & ImpulseDirection);
+	bool CCEKnockback(const float Duration, const FVector& ImpulseDirection);
+
+protected:
+
+	//~ The Apply functions below apply their effect without checking CanReceiveCCE. They are only called by the CCE functions above
+	//~ and by ApplyCCE, which checks CanReceiveCCE once per hit.
+
+	/** Flinch this character (visual feedback) */
+	virtual bool ApplyFlinch(const float BCAngle);
+
+	/** Interrupt this character's current action */
+	virtual bool ApplyInterrupt(const float BCAngle);
+
+	/** Applies stun to this character */
+	virtual bool ApplyStun(const float Duration);
+
+	/** Freeze this character */
+	virtual bool ApplyFreeze(const float Duration);
+
+	/** Knockdown this character */
+	virtual bool ApplyKnockdown(const float Duration);
+
+	/** Knockback this character */
+	virtual bool ApplyKnockback(const float Duration, const FVector& ImpulseDirection);
+
+public:
 
 	/** Simulates the knock back effect */
 	UFUNCTION(BlueprintNativeEvent, BlueprintCallable, Category = "CrowdControlEffect|Movement")
@@ -1061,8 +1108,8 @@ public:
 	//  Gameplay Events
 	// --------------------------------------
 
-	virtual void DodgeAttack(AActor* HitInstigator, ICombatInterface* InstigatorCI, const TSharedPtr<FAttackInfo>& AttackInfoPtr);
-	virtual void BlockAttack(AActor* HitInstigator, ICombatInterface* InstigatorCI, const TSharedPtr<FAttackInfo>& AttackInfoPtr);
+	virtual void DodgeAttack(AActor* HitInstigator, ICombatInterface* InstigatorCI, const FAttackInfo& AttackInfo);
+	virtual void BlockAttack(AActor* HitInstigator, ICombatInterface* InstigatorCI, const FAttackInfo& AttackInfo);
 
 	FOnGameplayEventMCDelegate OnReceivingHit;
 	FOnGameplayEventMCDelegate OnSuccessfulHit;
@@ -1290,6 +1337,13 @@ protected:
 	
 };
 
+FORCEINLINE bool AEODCharacterBase::CanReceiveCCE(ECrowdControlEffect CCE, bool bAttackBlocked) const
+{
+	const UStatsComponentBase* StatsComp = GetStatsComponent();
+	const uint8 ImmunityMask = StatsComp ? StatsComp->CCImmunities.GetImmunityMask() : 0;
+	return FCCImmunities::CanApplyCCE(ImmunityMask, CCE, bAttackBlocked, CharacterStateInfo.CharacterState == ECharacterState::Dead);
+}
+
 inline void AEODCharacterBase::StartBlockingDamage(float Delay)
 {
 	if (Role < ROLE_Authority)
@@ -8,6 +8,7 @@
 
 class USoundBase;
 class UActiveSkillBase;
+struct FDamageOutcome;
 
 /** An interface that must be implemented by all in-game actors that can engage in combat */
 UINTERFACE(BlueprintType)
@@ -34,24 +35,31 @@ public:
 
 	virtual AActor* GetInterfaceOwner();
 
-	virtual TSharedPtr<FAttackInfo> GetAttackInfoPtr(const FName& SkillGroup, const int32 CollisionIndex);
+	/** Fills OutAttackInfo with the attack info of the given skill group and collision index. Returns false if there is no such attack */
+	virtual bool GetAttackInfo(const FName& SkillGroup, const int32 CollisionIndex, FAttackInfo& OutAttackInfo);
 
 	virtual bool IsEnemyOf(ICombatInterface* TargetCI) const;
 
-	virtual void PostAttack(const TArray<FAttackResponse>& AttackResponses, const TArray<AActor*> HitActors);
+	virtual void PostAttack(const TArray<FAttackResponse>& AttackResponses, const TArray<AActor*>& HitActors);
 
-	virtual TSharedPtr<FAttackResponse> ReceiveAttack(
+	/**
+	 * Receives an attack and fills OutAttackResponse. Returns false if the attack could not be received.
+	 * If PrecomputedDamage is set, its crit roll and damage are used instead of calculating the damage of the attack.
+	 */
+	virtual bool ReceiveAttack(
 		AActor* HitInstigator,
 		ICombatInterface* InstigatorCI,
-		const TSharedPtr<FAttackInfo>& AttackInfoPtr,
+		const FAttackInfo& AttackInfo,
 		const FHitResult& DirectHitResult,
 		const bool bLineHitResultFound,
-		const FHitResult& LineHitResult);
+		const FHitResult& LineHitResult,
+		FAttackResponse& OutAttackResponse,
+		const FDamageOutcome* PrecomputedDamage = nullptr);
 
 	virtual float GetActualDamage(
 		AActor* HitInstigator,
 		ICombatInterface* InstigatorCI,
-		const TSharedPtr<FAttackInfo>& AttackInfoPtr,
+		const FAttackInfo& AttackInfo,
 		const bool bCritHit,
 		const bool bAttackBlocked);
 
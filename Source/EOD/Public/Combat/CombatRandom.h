@@ -0,0 +1,42 @@
+// Copyright 2018 Moikkai Games. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Random numbers used by combat during an encounter, seeded from the game mode.
+ * Every attack gets its own random stream derived from the encounter seed and the index of the attack,
+ * so the rolls of an attack don't depend on how many random numbers were drawn before it.
+ */
+struct EOD_API FCombatRandom
+{
+	FCombatRandom();
+
+	/** Restarts the encounter with the given seed */
+	void Initialize(int32 InEncounterSeed);
+
+	FORCEINLINE int32 GetEncounterSeed() const { return EncounterSeed; }
+
+	/** Returns the index in this encounter of the attack that the next call to NextAttackStream is for */
+	FORCEINLINE uint32 GetNextAttackIndex() const { return NextAttackIndex; }
+
+	/** Returns the random stream of the next attack of this encounter */
+	FRandomStream NextAttackStream();
+
+	/** Returns the random stream of the attack at AttackIndex of the encounter with the given seed. Used for reproducing the rolls of recorded attacks */
+	static FRandomStream GetAttackStream(int32 EncounterSeed, uint32 AttackIndex);
+
+	/** Random stream used for decisions that are not tied to an attack, e.g. AI skill selection */
+	FORCEINLINE const FRandomStream& GetDecisionStream() const { return DecisionStream; }
+
+private:
+
+	int32 EncounterSeed;
+
+	/** Index of the next attack of this encounter */
+	uint32 NextAttackIndex;
+
+	FRandomStream DecisionStream;
+
+};
@@ -0,0 +1,160 @@
+// Copyright 2018 Moikkai Games. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CombatLibrary.h"
+#include "DamageCalculator.h"
+
+/** Types of events stored by FCombatRecorder */
+enum class ECombatRecordType : uint8
+{
+	/** A melee swing resolved by the combat manager, stored as FCombatHitRequestRecord */
+	HitRequest,
+	/** An attack received by its target, stored as FCombatAttackRecord */
+	Attack
+};
+
+/** A melee swing resolved by the combat manager */
+struct FCombatHitRequestRecord
+{
+	/** World time at which the swing was resolved */
+	float Timestamp;
+
+	uint32 InstigatorId;
+
+	/** CRC of the skill group name, since FName indices are not stable between runs */
+	uint32 SkillGroupHash;
+
+	int32 CollisionIndex;
+
+	/** Number of actors hit by the collision sweeps of the swing */
+	int32 NumHits;
+};
+
+/** An attack received by its target, with everything needed to replay its damage and crowd control resolution */
+struct FCombatAttackRecord
+{
+	/** World time at which the attack was received */
+	float Timestamp;
+
+	uint32 InstigatorId;
+
+	uint32 TargetId;
+
+	/** Index of the attack in its encounter. The crit roll of the attack can be derived from this and the encounter seed */
+	uint32 AttackIndex;
+
+	float CritRoll;
+
+	float CritRate;
+
+	float NormalDamage;
+
+	float CritDamage;
+
+	float CrowdControlEffectDuration;
+
+	/** Defense of the target against the attack */
+	FDamageDefense Defense;
+
+	EDamageType DamageType;
+
+	ECrowdControlEffect CrowdControlEffect;
+
+	/** CC immunities of the target before it received the attack */
+	uint8 TargetCCImmunities;
+
+	uint8 bUndodgable : 1;
+
+	uint8 bUnblockable : 1;
+
+	/** True if the target was dead before it received the attack */
+	uint8 bTargetDead : 1;
+
+	uint8 bCritHit : 1;
+
+	EDamageResult DamageResult;
+
+	/** Crowd control effect the target received. Flinch if the crowd control effect of the attack was not applied */
+	ECrowdControlEffect ReceivedCrowdControlEffect;
+
+	int32 ActualDamage;
+
+	float BCAngle;
+
+	/** Returns the attack info that the attack was received with */
+	FAttackInfo GetAttackInfo() const;
+};
+
+/** Events loaded from a combat recording saved by FCombatRecorder */
+struct FCombatRecording
+{
+	int32 EncounterSeed;
+
+	TArray<FCombatHitRequestRecord> HitRequests;
+
+	TArray<FCombatAttackRecord> Attacks;
+};
+
+/**
+ * Records combat events into a fixed size binary ring buffer. Once the buffer is full, the oldest events are dropped to make room for new ones.
+ * Each event is stored as its ECombatRecordType byte followed by the raw bytes of its record, and may wrap around the end of the buffer.
+ */
+class EOD_API FCombatRecorder
+{
+public:
+
+	FCombatRecorder();
+
+	/** Clears the buffer and starts recording events of the encounter with the given seed into a ring buffer of CapacityBytes */
+	void Start(int32 CapacityBytes, int32 EncounterSeed);
+
+	/** Stops recording. Recorded events are kept until recording is started again */
+	void Stop();
+
+	FORCEINLINE bool IsRecording() const { return bRecording; }
+
+	void RecordHitRequest(const FCombatHitRequestRecord& Record);
+
+	void RecordAttack(const FCombatAttackRecord& Record);
+
+	/** Number of events dropped because the buffer was full */
+	FORCEINLINE int32 GetNumDroppedEvents() const { return NumDroppedEvents; }
+
+	/** Writes the recorded events, oldest first, to Filename. Returns false if the file could not be written */
+	bool SaveToFile(const FString& Filename) const;
+
+	/** Reads the events of a recording written by SaveToFile. Returns false if the file could not be read or is not a combat recording */
+	static bool LoadFromFile(const FString& Filename, FCombatRecording& OutRecording);
+
+private:
+
+	static int32 GetRecordSize(ECombatRecordType Type);
+
+	void Write(ECombatRecordType Type, const void* Record, int32 RecordSize);
+
+	/** Copies Size bytes to the buffer at Offset, wrapping around the end of the buffer */
+	void WriteBytes(int32 Offset, const void* Data, int32 Size);
+
+	/** Copies Size bytes from the buffer at Offset, wrapping around the end of the buffer */
+	void ReadBytes(int32 Offset, void* Data, int32 Size) const;
+
+	/** Drops the oldest event in the buffer */
+	void DropOldestEvent();
+
+	TArray<uint8> Buffer;
+
+	/** Offset of the oldest event */
+	int32 Tail;
+
+	/** Number of bytes used by recorded events */
+	int32 NumUsedBytes;
+
+	int32 NumDroppedEvents;
+
+	int32 EncounterSeed;
+
+	bool bRecording;
+
+};
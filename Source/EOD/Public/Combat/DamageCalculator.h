@@ -0,0 +1,142 @@
+// Copyright 2018 Moikkai Games. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CombatLibrary.h"
+
+class UStatsComponentBase;
+struct FStatsSnapshot;
+
+/** Defender stats that reduce the damage of an attack, resolved for the damage type of the attack */
+struct FDamageDefense
+{
+	/** Physical or magickal resistance of the defender */
+	float Resistance;
+
+	/** Percentage of damage negated if the attack is blocked */
+	float BlockReduction;
+
+	/** Multiplier applied to the damage for elemental strengths and weaknesses */
+	float ElementalMultiplier;
+
+	FDamageDefense() :
+		Resistance(0.f),
+		BlockReduction(0.f),
+		ElementalMultiplier(1.f)
+	{
+	}
+};
+
+/** Damage of a single attack, for both outcomes of the defender blocking it */
+struct FDamageOutcome
+{
+	bool bCritHit;
+
+	/** Damage dealt if the attack is not blocked */
+	float Damage;
+
+	/** Damage dealt if the attack is blocked */
+	float BlockedDamage;
+
+	FDamageOutcome() :
+		bCritHit(false),
+		Damage(0.f),
+		BlockedDamage(0.f)
+	{
+	}
+
+	FORCEINLINE float GetDamage(bool bAttackBlocked) const { return bAttackBlocked ? BlockedDamage : Damage; }
+};
+
+/**
+ * Calculates the damage of attacks from the attack info of the attacker and the defense of the defender.
+ * The attacker's stats are already folded into FAttackInfo by ICombatInterface::GetAttackInfo.
+ *
+ * Damage = (bCritHit ? CritDamage : NormalDamage) * ResistanceFactor * ElementalMultiplier
+ * BlockedDamage = Damage * (1 - BlockReduction / 100)
+ */
+struct EOD_API FDamageCalculator
+{
+	/** Returns the defense of a defender against attacks of DamageType */
+	static FDamageDefense GetDefense(const UStatsComponentBase* StatsComp, EDamageType DamageType);
+
+	/** Returns the defense of a defender, captured in StatsSnapshot, against attacks of DamageType */
+	static FDamageDefense GetDefense(const FStatsSnapshot& StatsSnapshot, EDamageType DamageType);
+
+	/**
+	 * Returns the damage of a single attack. Gives the same result as calculating the attack in an FDamageBatch with the same crit roll,
+	 * which the CombatReplay commandlet verifies for every recorded attack.
+	 */
+	static FDamageOutcome CalculateDamage(const FAttackInfo& AttackInfo, const FDamageDefense& Defense, bool bCritHit);
+
+	/** Returns a crit roll in the range [0, 100) drawn from RandomStream */
+	FORCEINLINE static float RollCrit(const FRandomStream& RandomStream) { return RandomStream.FRandRange(0.f, 100.f); }
+
+	/** Returns true if an attack with CritRate crits for the given roll in the range [0, 100) */
+	FORCEINLINE static bool IsCritRoll(float CritRate, float CritRoll) { return CritRate >= CritRoll; }
+
+	/** Returns the multiplier applied to damage for the given resistance */
+	static float GetResistanceFactor(float Resistance);
+
+	/** Returns the multiplier applied to damage of a blocked attack for the given block reduction */
+	static float GetBlockFactor(float BlockReduction);
+};
+
+/**
+ * Calculates the damage of many attacks at once.
+ * Attacks are stored as a structure of arrays padded to the SIMD width, and their damage is calculated in a single branchless vectorized pass.
+ * Used by the combat manager for resolving all melee attacks, and by balance tools for simulating large numbers of attacks offline.
+ */
+class EOD_API FDamageBatch
+{
+public:
+
+	FDamageBatch();
+
+	/** Removes all attacks from the batch without freeing memory */
+	void Reset();
+
+	/** Adds an attack with the given crit roll to the batch and returns its index */
+	int32 AddAttack(const FAttackInfo& AttackInfo, const FDamageDefense& Defense, float CritRoll);
+
+	/** Calculates the damage of all attacks in the batch */
+	void Calculate();
+
+	FORCEINLINE int32 Num() const { return NumAttacks; }
+
+	/** Returns the damage of the attack at Index. Only valid after Calculate */
+	FDamageOutcome GetOutcome(int32 Index) const;
+
+	uint32 GetAllocatedSize() const;
+
+private:
+
+	/** Number of attacks calculated by a single vector operation */
+	static const int32 LaneWidth = 4;
+
+	typedef TArray<float, TAlignedHeapAllocator<16>> FDamageLane;
+
+	int32 NumAttacks;
+
+	FDamageLane NormalDamage;
+
+	FDamageLane CritDamage;
+
+	FDamageLane CritRate;
+
+	/** Product of the resistance factor and the elemental multiplier of each attack */
+	FDamageLane DefenseFactor;
+
+	FDamageLane BlockFactor;
+
+	FDamageLane CritRolls;
+
+	FDamageLane Damage;
+
+	FDamageLane BlockedDamage;
+
+	/** Crit results of each group of LaneWidth attacks, one bit per attack */
+	TArray<uint8> CritMasks;
+
+};
@@ -0,0 +1,148 @@
+// Copyright 2018 Moikkai Games. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CharacterLibrary.h"
+
+class AActor;
+class AEODCharacterBase;
+
+/** Filter applied to the candidates returned by FCharacterSpatialHash queries */
+struct FCharacterQueryFilter
+{
+	/** Actor that should never be returned, usually the actor doing the query */
+	const AActor* IgnoredActor;
+
+	/** If set, only characters with a different faction than this character are returned */
+	const AEODCharacterBase* EnemiesOf;
+
+	FCharacterQueryFilter() :
+		IgnoredActor(nullptr),
+		EnemiesOf(nullptr)
+	{
+	}
+
+	FCharacterQueryFilter(const AActor* InIgnoredActor, const AEODCharacterBase* InEnemiesOf = nullptr) :
+		IgnoredActor(InIgnoredActor),
+		EnemiesOf(InEnemiesOf)
+	{
+	}
+};
+
+/**
+ * A uniform grid of character locations and factions on the XY plane.
+ * Used as a broadphase for combat and aggro queries, so that physics scene queries
+ * are only issued when there is a character that can actually be hit.
+ */
+class EOD_API FCharacterSpatialHash
+{
+public:
+
+	FCharacterSpatialHash();
+
+	/** Size of a single grid cell in cm */
+	float CellSize;
+
+	// --------------------------------------
+	//  Registration
+	// --------------------------------------
+
+	void AddCharacter(AEODCharacterBase* Character);
+
+	void RemoveCharacter(AEODCharacterBase* Character);
+
+	/**
+	 * Rebuilds the grid from current character locations unless it has already been rebuilt for FrameNumber.
+	 * Entry bounds are padded by how far each character can move in DeltaSeconds, since characters that
+	 * move later in the same frame are not re-indexed.
+	 */
+	void UpdateForFrame(uint64 FrameNumber, float DeltaSeconds);
+
+	/** Forces a rebuild on the next UpdateForFrame, e.g. after characters have been moved mid frame */
+	FORCEINLINE void MarkDirty() { LastUpdateFrame = MAX_uint64; }
+
+	/**
+	 * Grows the bounds of Character's entry to also cover Bounds without rebuilding the grid.
+	 * Meant for meshes that are moved mid frame while their actor stays in place, e.g. by lag compensation.
+	 * Writes the previous bounds to OutOldBounds. Returns false if Character is not in the grid.
+	 */
+	bool ExpandEntryBounds(const AEODCharacterBase* Character, const FBox& Bounds, FBox& OutOldBounds);
+
+	/** Restores the bounds that ExpandEntryBounds returned for Character */
+	void RestoreEntryBounds(const AEODCharacterBase* Character, const FBox& OldBounds);
+
+	// --------------------------------------
+	//  Queries
+	// --------------------------------------
+
+	/** Finds characters whose bounds overlap the sphere. Returns true if any were found */
+	bool QuerySphere(const FVector& Center, float Radius, const FCharacterQueryFilter& Filter, TArray<AEODCharacterBase*>& OutCharacters) const;
+
+	/** Finds characters whose bounds overlap the bounds of the capsule. Returns true if any were found */
+	bool QueryCapsule(const FVector& Center, const FQuat& Rotation, float Radius, float HalfHeight, const FCharacterQueryFilter& Filter, TArray<AEODCharacterBase*>& OutCharacters) const;
+
+	/** Finds characters whose bounds overlap the bounds of the box. Returns true if any were found */
+	bool QueryBox(const FVector& Center, const FQuat& Rotation, const FVector& HalfExtent, const FCharacterQueryFilter& Filter, TArray<AEODCharacterBase*>& OutCharacters) const;
+
+	/** Returns true if any character's bounds overlap the sphere */
+	bool AnyInSphere(const FVector& Center, float Radius, const FCharacterQueryFilter& Filter) const;
+
+	/** Returns true if any character's bounds overlap the bounds of the capsule */
+	bool AnyInCapsule(const FVector& Center, const FQuat& Rotation, float Radius, float HalfHeight, const FCharacterQueryFilter& Filter) const;
+
+	/** Returns true if any character's bounds overlap the bounds of the box */
+	bool AnyInBox(const FVector& Center, const FQuat& Rotation, const FVector& HalfExtent, const FCharacterQueryFilter& Filter) const;
+
+	/** Returns the axis aligned bounds of a capsule with the given orientation */
+	static FBox GetCapsuleBounds(const FVector& Center, const FQuat& Rotation, float Radius, float HalfHeight);
+
+	/** Returns the axis aligned bounds of a box with the given orientation */
+	static FBox GetBoxBounds(const FVector& Center, const FQuat& Rotation, const FVector& HalfExtent);
+
+private:
+
+	struct FEntry
+	{
+		AEODCharacterBase* Character;
+
+		/** Axis aligned bounds of the character's capsule and mesh at the time of last rebuild, padded by the character's movement in one frame */
+		FBox Bounds;
+
+		EFaction Faction;
+
+		FIntPoint Cell;
+	};
+
+	FORCEINLINE FIntPoint GetCell(float X, float Y) const
+	{
+		return FIntPoint(FMath::FloorToInt(X / CellSize), FMath::FloorToInt(Y / CellSize));
+	}
+
+	static bool PassesFilter(const FEntry& Entry, const FCharacterQueryFilter& Filter);
+
+	/** Returns the entry of Character, or nullptr if it is not in the grid */
+	FEntry* FindEntry(const AEODCharacterBase* Character);
+
+	/**
+	 * Calls Visitor for every entry in the cells overlapped by QueryBounds that passes Filter.
+	 * Iteration stops as soon as Visitor returns false.
+	 */
+	template<typename VisitorType>
+	void VisitCandidates(const FBox& QueryBounds, const FCharacterQueryFilter& Filter, VisitorType Visitor) const;
+
+	/** All registered characters */
+	TArray<TWeakObjectPtr<AEODCharacterBase>> Characters;
+
+	/** Entries sorted by cell */
+	TArray<FEntry> Entries;
+
+	/** Maps a cell to the index of its first entry (X) and the number of entries in it (Y) */
+	TMap<FIntPoint, FIntPoint> CellRanges;
+
+	/** The largest XY extent of any entry. Queries are expanded by this since entries are bucketed by their center */
+	float MaxEntryExtent;
+
+	uint64 LastUpdateFrame;
+
+};
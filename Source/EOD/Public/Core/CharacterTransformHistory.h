@@ -0,0 +1,47 @@
+// Copyright 2018 Moikkai Games. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** A fixed size ring buffer of recent world transforms of a character's mesh, used for rewinding hit targets on server */
+class EOD_API FCharacterTransformHistory
+{
+public:
+
+	/** Number of samples kept. At a 30 Hz server tick this covers a little over a second */
+	static const int32 Capacity = 36;
+
+	FCharacterTransformHistory();
+
+	/** Records the transform at Timestamp. Timestamps must be recorded in increasing order */
+	void Record(float Timestamp, const FTransform& Transform);
+
+	/**
+	 * Finds the transform at Timestamp by interpolating between the two samples around it.
+	 * Timestamps older than the oldest sample are clamped to it. Returns false if nothing has been recorded yet.
+	 */
+	bool Sample(float Timestamp, FTransform& OutTransform) const;
+
+	void Reset();
+
+	FORCEINLINE int32 Num() const { return NumSamples; }
+
+private:
+
+	/** Returns the index in Samples of the sample that was recorded Age samples ago */
+	FORCEINLINE int32 GetSampleIndex(int32 Age) const
+	{
+		return (Head - Age + Capacity) % Capacity;
+	}
+
+	float Timestamps[Capacity];
+
+	FTransform Transforms[Capacity];
+
+	/** Index of the most recent sample */
+	int32 Head;
+
+	int32 NumSamples;
+
+};
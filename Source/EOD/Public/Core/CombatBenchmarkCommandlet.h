@@ -0,0 +1,59 @@
+// Copyright 2018 Moikkai Games. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "CombatBenchmarkCommandlet.generated.h"
+
+class UWorld;
+class UGameInstance;
+class AAICharacterBase;
+
+/**
+ * Runs a headless combat simulation and reports combat throughput. Intended to gate combat performance regressions on build agents.
+ *
+ * Spawns CharactersPerClass AI characters of every class in Classes (at least two factions, usually one class per faction) in an empty world,
+ * lines the groups up against each other and ticks the world a fixed number of times with a fixed delta time and random seed.
+ *
+ * Usage:
+ * UE4Editor-Cmd EOD.uproject -run=CombatBenchmark -Classes=/Game/Path/BP_A.BP_A_C,/Game/Path/BP_B.BP_B_C -nullrhi -unattended
+ *		[-CharactersPerClass=20] [-Ticks=3000] [-TickRate=30] [-Seed=1] [-GameMode=/Script/EOD.PVEOnlyModeBase]
+ *		[-Output=Path/To/Report.json] [-MaxResolveMsPerRequest=0.5] [-Record=Path/To/Combat.eodcombat]
+ *
+ * If Record is set, combat is recorded during the benchmark and saved for replaying with the CombatReplay commandlet.
+ *
+ * Returns 0 on success, 1 if the benchmark could not be set up, 2 if MaxResolveMsPerRequest was exceeded,
+ * and 3 if no attack landed during the benchmark.
+ */
+UCLASS()
+class EOD_API UCombatBenchmarkCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+
+	UCombatBenchmarkCommandlet(const FObjectInitializer& ObjectInitializer);
+
+	virtual int32 Main(const FString& Params) override;
+
+private:
+
+	/** Creates a standalone game world with the given game mode and combat random seed and begins play in it. Returns nullptr on failure */
+	UWorld* CreateBenchmarkWorld(const FString& GameModePath, int32 CombatSeed, UGameInstance*& OutGameInstance) const;
+
+	void DestroyBenchmarkWorld(UWorld* World, UGameInstance* GameInstance) const;
+
+	/** Spawns a floor for the characters to stand on */
+	void SpawnFloor(UWorld* World) const;
+
+	/** Spawns a grid of NumCharacters characters of CharacterClass facing the world origin from the direction at GroupAngle */
+	void SpawnCharacterGroup(
+		UWorld* World,
+		UClass* CharacterClass,
+		int32 NumCharacters,
+		float GroupAngle,
+		FRandomStream& RandomStream,
+		TArray<AAICharacterBase*>& OutCharacters) const;
+
+};
@@ -6,7 +6,13 @@
 #include "EODCharacterBase.h"
 #include "CharacterLibrary.h"
 #include "CombatLibrary.h"
+#include "CharacterSpatialHash.h"
+#include "DamageCalculator.h"
+#include "CombatRandom.h"
+#include "CombatRecorder.h"
+#include "AILibrary.h"
 
+#include "WorldCollision.h"
 #include "Camera/CameraShake.h"
 #include "GameFramework/Info.h"
 #include "CombatManager.generated.h"
@@ -14,10 +20,137 @@
 class AActor;
 class UCameraShake;
 class APlayerCharacter;
+
+/** A single collision test result that is waiting to be resolved by the combat manager */
+struct FMeleeHitRequest
+{
+	/** The actor that initiated the collision test */
+	TWeakObjectPtr<AActor> HitInstigator;
+
+	/** Skill info of the notify that generated this request */
+	FCollisionSkillInfo CollisionSkillInfo;
+
+	/** Identifies the swing that generated this request. Requests of all capsules of one notify share the same swing id */
+	uint32 SwingId;
+
+	/** World time that characters were rewound to when the collision test was done, or a negative value if they were not rewound */
+	float RewindTimestamp;
+
+	/** Index of the first hit result of this request inside ACombatManager::PendingHitResults */
+	int32 FirstHitIndex;
+
+	/** Number of hit results that belong to this request */
+	int32 NumHits;
+};
+
+/** A melee attack that is waiting on the result of an async line trace before it can be received by the target */
+struct FDeferredMeleeAttack
+{
+	TWeakObjectPtr<AActor> HitInstigator;
+
+	TWeakObjectPtr<AActor> HitTarget;
+
+	FAttackInfo AttackInfo;
+
+	/** Hit result of the collision sweep that hit the target */
+	FHitResult HitResult;
+
+	/** Handle of the async line trace issued for this attack */
+	FTraceHandle TraceHandle;
+
+	/** Line hit result filled in once the async line trace completes */
+	FHitResult LineHitResult;
+
+	bool bLineHitResultFound;
+
+	/** True once the async line trace has completed, or if no trace was issued */
+	bool bTraceCompleted;
+
+	/** Frame in which the attack was deferred */
+	uint64 DeferredFrame;
+
+	/** Index of the attack in the encounter, assigned when its damage is calculated */
+	uint32 AttackIndex;
+
+	float CritRoll;
+
+	/** Defense of the target when the damage of the attack was calculated */
+	FDamageDefense Defense;
+};
+
+/** Counters of the work done by the combat manager since statistics were last reset. Used for benchmarking combat */
+struct FCombatManagerStatistics
+{
+	/** Number of melee hit requests queued */
+	int32 NumMeleeRequests;
+
+	/** Number of attacks received by their targets */
+	int32 NumAttacksReceived;
+
+	/** Number of combat collision sweeps done by collision notifies */
+	int32 NumCombatSweeps;
+
+	/** Number of line traces issued for finding the impact normal of hits */
+	int32 NumLineTraces;
+
+	/** Total time spent resolving melee attacks */
+	double ResolveSeconds;
+
+	/** The largest size the hit pipeline buffers have grown to */
+	uint32 PeakBuffersSize;
+
+	FCombatManagerStatistics() :
+		NumMeleeRequests(0),
+		NumAttacksReceived(0),
+		NumCombatSweeps(0),
+		NumLineTraces(0),
+		ResolveSeconds(0.0),
+		PeakBuffersSize(0)
+	{
+	}
+};
+
+/** A character whose mesh has been moved back in time by ACombatManager::RewindCharacters */
+struct FRewoundCharacter
+{
+	TWeakObjectPtr<AEODCharacterBase> Character;
+
+	/** Relative transform of the mesh before it was rewound */
+	FTransform MeshRelativeTransform;
+
+	/** Bounds of the character in the spatial hash before they were expanded to cover the rewound mesh */
+	FBox SpatialHashBounds;
+
+	bool bSpatialHashBoundsExpanded;
+};
+
+/** A target of a melee swing, collected before any of the swing's attacks are received */
+struct FMeleeSwingTarget
+{
+	AActor* HitActor;
+
+	ICombatInterface* TargetCI;
+
+	/** Hit result of the collision sweep that hit the target */
+	const FHitResult* HitResult;
+
+	FHitResult LineHitResult;
+
+	bool bLineHitResultFound;
+
+	/** Index of the attack in the encounter, assigned when its damage is calculated */
+	uint32 AttackIndex;
+
+	float CritRoll;
+
+	/** Defense of the target when the damage of the attack was calculated */
+	FDamageDefense Defense;
+};
+
 /**
  * 
  */
-UCLASS(BlueprintType, Blueprintable)
+UCLASS(BlueprintType, Blueprintable, Config = Game)
 class EOD_API ACombatManager : public AInfo
 {
 	GENERATED_BODY()
@@ -32,31 +165,259 @@ public:
 
 	virtual void BeginPlay() override;
 
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 	virtual void Tick(float DeltaTime) override;
 
 	// --------------------------------------
 	//  Combat
 	// --------------------------------------
 
-	/** Called when an actor attacks another actor */
+	/** Returns a new swing id. Collision notifies should get one per swing and pass it with every request of that swing */
+	FORCEINLINE uint32 GenerateSwingId() { return ++LastSwingId; }
+
+	/**
+	 * Queues the result of a melee collision test for resolution during the next combat manager tick.
+	 * Requests with the same SwingId are resolved together, so an actor is never hit twice by the same swing.
+	 */
+	void QueueMeleeAttack(
+		AActor* HitInstigator,
+		const bool bHit,
+		const TArray<FHitResult>& HitResults,
+		const FCollisionSkillInfo& CollisionSkillInfo,
+		const uint32 SwingId);
+
+	/** Called when an actor attacks another actor. Resolves the attack immediately */
 	void OnMeleeAttack(
 		AActor* HitInstigator,
 		const bool bHit,
 		const TArray<FHitResult>& HitResults,
 		const FCollisionSkillInfo& CollisionSkillInfo);
 
-	TSharedPtr<FAttackResponse> ProcessAttack(
+	/**
+	 * Lets the target of SwingTarget receive the attack with the given damage and fills OutAttackResponse.
+	 * Returns false if the attack was not received.
+	 */
+	bool ProcessAttack(
 		AActor* HitInstigator,
 		ICombatInterface* InstigatorCI,
-		const TSharedPtr<FAttackInfo>& AttackInfoPtr,
-		AActor* HitTarget,
-		ICombatInterface* TargetCI,
-		const FHitResult& HitResult);
+		const FAttackInfo& AttackInfo,
+		const FMeleeSwingTarget& SwingTarget,
+		const FDamageOutcome& DamageOutcome,
+		FAttackResponse& OutAttackResponse);
 
 	//~ @todo OnRangedHit
 
+	/** Should be called by collision notifies for every combat collision sweep they do */
+	FORCEINLINE void RecordCombatSweep() { Statistics.NumCombatSweeps++; }
+
+	FORCEINLINE const FCombatManagerStatistics& GetStatistics() const { return Statistics; }
+
+	/** Random numbers of the current encounter. Initialized by the game mode with its combat random seed */
+	FORCEINLINE FCombatRandom& GetCombatRandom() { return CombatRandom; }
+
+	void ResetStatistics();
+
+	// --------------------------------------
+	//  Spatial Queries
+	// --------------------------------------
+
+	/** Registers a character with the spatial hash used as broadphase for combat and aggro queries */
+	void RegisterCharacter(AEODCharacterBase* Character);
+
+	void UnregisterCharacter(AEODCharacterBase* Character);
+
+	/** Returns the spatial hash of all registered characters, rebuilt at most once per frame */
+	const FCharacterSpatialHash& GetCharacterSpatialHash();
+
 	bool AreEnemies(AEODCharacterBase* CharOne, AEODCharacterBase* CharTwo);
 
+	/** Returns the state of Target for AI skill selection. Captured once per frame and shared by all AI characters targeting it */
+	const FAITargetSnapshot& GetTargetSnapshot(const AEODCharacterBase* Target);
+
+	/**
+	 * If true, line traces used for finding the impact normal of melee hits are issued asynchronously,
+	 * and the attacks are received by their targets once the trace results arrive.
+	 * Since the combat manager ticks after async traces are kicked off for the frame, this takes two frames.
+	 * Set to false to resolve melee hits synchronously in the same frame.
+	 */
+	UPROPERTY(Config, EditDefaultsOnly, Category = Combat)
+	bool bUseAsyncLineTraces;
+
+	// --------------------------------------
+	//  Combat Recording
+	// --------------------------------------
+
+	/** Starts recording melee swings and received attacks into a ring buffer of CombatRecordingBufferSize bytes. Clears any previous recording */
+	void StartCombatRecording();
+
+	void StopCombatRecording();
+
+	/** Saves the recorded combat events to Filename. They can be replayed with the CombatReplay commandlet */
+	bool SaveCombatRecording(const FString& Filename) const;
+
+	FORCEINLINE const FCombatRecorder& GetCombatRecorder() const { return CombatRecorder; }
+
+	/** If true, combat is recorded from the start of play and the recording is saved to Saved/CombatRecordings when play ends */
+	UPROPERTY(Config, EditDefaultsOnly, Category = CombatRecording)
+	bool bRecordCombat;
+
+	/** Size in bytes of the ring buffer combat is recorded into. The oldest events are dropped once it is full */
+	UPROPERTY(Config, EditDefaultsOnly, Category = CombatRecording)
+	int32 CombatRecordingBufferSize;
+
+	// --------------------------------------
+	//  Lag Compensation
+	// --------------------------------------
+
+	/** Returns the world time at which the client controlling HitInstigator saw the world. This is the current time for AI and local players */
+	float GetRewindTimestamp(const AActor* HitInstigator) const;
+
+	/**
+	 * Moves the meshes of characters around HitInstigator back to where they were at Timestamp.
+	 * Returns false if no character was rewound, or if characters are already rewound.
+	 */
+	bool RewindCharacters(const AActor* HitInstigator, float Timestamp);
+
+	/** Moves the meshes of rewound characters back to their current position */
+	void RestoreRewoundCharacters();
+
+	/** If true, melee collision of remote players is tested against where their targets were on the player's screen */
+	UPROPERTY(Config, EditDefaultsOnly, Category = LagCompensation)
+	bool bEnableLagCompensation;
+
+	/** The maximum time in seconds that characters can be rewound by. Players with a higher latency will have to lead their hits */
+	UPROPERTY(Config, EditDefaultsOnly, Category = LagCompensation)
+	float MaxRewindTime;
+
+	/** Only characters within this distance of the hit instigator are rewound */
+	UPROPERTY(Config, EditDefaultsOnly, Category = LagCompensation)
+	float RewindRadius;
+
+private:
+
+	/** Returns the memory allocated by the request queues and scratch buffers of the hit pipeline */
+	uint32 GetCombatBuffersAllocatedSize() const;
+
+	/** Resolves all melee hit requests queued since the last tick */
+	void ResolvePendingMeleeAttacks();
+
+	/** Lets targets receive the deferred melee attacks whose async line traces have completed */
+	void ResolveDeferredMeleeAttacks();
+
+	/**
+	 * Issues an async line trace from HitInstigator to the component hit by the collision sweep and defers the attack.
+	 * If bSyncLineTrace is true, the line trace is done immediately instead, e.g. because the targets are currently rewound
+	 * and an async trace would only run after they have been restored.
+	 */
+	void DeferMeleeAttack(
+		AActor* HitInstigator,
+		const FAttackInfo& AttackInfo,
+		AActor* HitTarget,
+		const FHitResult& HitResult,
+		const bool bSyncLineTrace);
+
+	/** Fills the parts of Record that are known before HitTarget receives the attack */
+	void BeginAttackRecord(
+		FCombatAttackRecord& Record,
+		const AActor* HitInstigator,
+		const AActor* HitTarget,
+		const FAttackInfo& AttackInfo,
+		const FDamageDefense& Defense,
+		const uint32 AttackIndex,
+		const float CritRoll) const;
+
+	/** Fills the results of the attack in Record once HitTarget has received it */
+	void FinishAttackRecord(FCombatAttackRecord& Record, const AActor* HitTarget, const FAttackResponse& AttackResponse) const;
+
+	/** Called when an async line trace issued by DeferMeleeAttack completes */
+	void OnLineTraceCompleted(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum);
+
+	/**
+	 * Resolves a run of requests that belong to a single swing of HitInstigator.
+	 * Appends the responses and hit actors to OutAttackResponses and OutHitActors.
+	 * If RewindTimestamp is not negative, the line traces of the swing are done with characters rewound to it.
+	 * If bDeferAttacks is true, the attacks are deferred until their async line traces complete and no responses are appended.
+	 */
+	void ResolveMeleeSwing(
+		AActor* HitInstigator,
+		ICombatInterface* InstigatorCI,
+		const FCollisionSkillInfo& CollisionSkillInfo,
+		const FHitResult* HitResults,
+		const int32 NumHits,
+		const float RewindTimestamp,
+		const bool bDeferAttacks,
+		TArray<FAttackResponse>& OutAttackResponses,
+		TArray<AActor*>& OutHitActors);
+
+	/** Spatial hash of all characters in the world */
+	FCharacterSpatialHash CharacterSpatialHash;
+
+	/** Melee hit requests waiting to be resolved */
+	TArray<FMeleeHitRequest> PendingMeleeRequests;
+
+	/** Hit results of all pending melee requests, stored contiguously */
+	TArray<FHitResult> PendingHitResults;
+
+	/** The last swing id returned by GenerateSwingId */
+	uint32 LastSwingId;
+
+	/** Scratch buffer reused for attack responses of each instigator during resolution */
+	TArray<FAttackResponse> ScratchAttackResponses;
+
+	/** Scratch buffer reused for actors hit by each instigator during resolution */
+	TArray<AActor*> ScratchHitActors;
+
+	/** Scratch buffer reused for the targets of each swing during resolution */
+	TArray<FMeleeSwingTarget> ScratchSwingTargets;
+
+	/** Scratch buffer reused for the results of synchronous line traces */
+	mutable TArray<FHitResult> ScratchLineHitResults;
+
+	/** Melee attacks waiting on async line trace results, in the order they were deferred */
+	TArray<FDeferredMeleeAttack> DeferredMeleeAttacks;
+
+	/**
+	 * Sequence number of the first attack in DeferredMeleeAttacks. Every deferred attack gets the next sequence number,
+	 * which is passed as the user data of its trace so the attack can be found once the trace completes.
+	 */
+	uint32 FirstDeferredSequence;
+
+	/** Deferred attacks are resolved without a line hit result if their trace hasn't completed after this many frames */
+	static const uint64 MaxDeferredFrames = 4;
+
+	/** Damage of the deferred melee attacks, indexed the same as DeferredMeleeAttacks */
+	FDamageBatch DeferredDamageBatch;
+
+	/** Damage of the targets of the swing being resolved, indexed the same as ScratchSwingTargets */
+	FDamageBatch SwingDamageBatch;
+
+	FCombatRandom CombatRandom;
+
+	FCombatRecorder CombatRecorder;
+
+	FTraceDelegate LineTraceDelegate;
+
+	/** Mutable since line traces are counted from const methods */
+	mutable FCombatManagerStatistics Statistics;
+
+	/** Characters that are currently rewound */
+	TArray<FRewoundCharacter> RewoundCharacters;
+
+	/** The world time that RewoundCharacters are rewound to */
+	float RewoundTimestamp;
+
+	/** Scratch buffer reused for finding the characters to rewind */
+	TArray<AEODCharacterBase*> ScratchRewindCandidates;
+
+	/** Snapshots of characters targeted by AI this frame */
+	TMap<const AEODCharacterBase*, FAITargetSnapshot> TargetSnapshots;
+
+	/** Frame that TargetSnapshots were captured in */
+	uint64 TargetSnapshotsFrame;
+
+public:
+
 	// --------------------------------------
 	//  Utility
 	// --------------------------------------
@@ -87,6 +448,36 @@ public:
 
 };
 
+/** Rewinds the characters around HitInstigator to where its client saw them, for the lifetime of this scope */
+struct FScopedCombatRewind
+{
+	FScopedCombatRewind(ACombatManager* InCombatManager, const AActor* HitInstigator) :
+		CombatManager(InCombatManager),
+		bRewound(false)
+	{
+		if (CombatManager && CombatManager->bEnableLagCompensation)
+		{
+			const float Timestamp = CombatManager->GetRewindTimestamp(HitInstigator);
+			bRewound = Timestamp < CombatManager->GetWorld()->GetTimeSeconds() && CombatManager->RewindCharacters(HitInstigator, Timestamp);
+		}
+	}
+
+	~FScopedCombatRewind()
+	{
+		if (bRewound)
+		{
+			CombatManager->RestoreRewoundCharacters();
+		}
+	}
+
+private:
+
+	ACombatManager* CombatManager;
+
+	bool bRewound;
+
+};
+
 inline float ACombatManager::CalculateAngleBetweenVectors(FVector Vec1, FVector Vec2)
 {
 	FVector NormalizedVec1 = Vec1.GetSafeNormal();
@@ -0,0 +1,32 @@
+// Copyright 2018 Moikkai Games. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "CombatReplayCommandlet.generated.h"
+
+/**
+ * Replays a combat recording saved by the combat manager through the damage and crowd control logic, without creating a world.
+ * Every recorded attack is recalculated from its recorded inputs and compared against its recorded result,
+ * and the recalculation is timed to profile combat resolution far faster than real time.
+ *
+ * Usage:
+ * UE4Editor-Cmd EOD.uproject -run=CombatReplay -Recording=Path/To/Combat.eodcombat [-Iterations=1] -nullrhi -unattended
+ *
+ * Returns 0 if every attack replayed to its recorded result, 1 if the recording could not be loaded,
+ * and 2 if the crit roll or damage of any attack differed from the recording, or if FDamageBatch and the scalar
+ * FDamageCalculator::CalculateDamage disagreed on any attack.
+ */
+UCLASS()
+class EOD_API UCombatReplayCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+
+	UCombatReplayCommandlet(const FObjectInitializer& ObjectInitializer);
+
+	virtual int32 Main(const FString& Params) override;
+
+};
@@ -14,6 +14,18 @@ class UDamageNumberWidget;
 class UMetaSaveGame;
 class UPlayerSaveGame;
 class APlayerSkillTreeManager;
+class UGameplaySkillBase;
+
+/** Skill objects created from the rows of a skills data table */
+USTRUCT()
+struct EOD_API FSharedSkillSet
+{
+	GENERATED_USTRUCT_BODY()
+
+	/** Skills indexed by their skill index. Index 0 is not a valid skill index and is always null */
+	UPROPERTY(Transient)
+	TArray<UGameplaySkillBase*> Skills;
+};
 
 /**
  * 
@@ -51,6 +63,17 @@ public:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = DataTable)
 	UDataTable* CharacterStatsDataTable;
 
+	// --------------------------------------
+	//	Shared Skills
+	// --------------------------------------
+
+	/**
+	 * Returns the skills created from the rows of SkillsDataTable, indexed by their skill index.
+	 * The skills are created the first time a data table is requested and are shared by every character that uses the same data table,
+	 * so they must not hold any per character state.
+	 */
+	const TArray<UGameplaySkillBase*>& GetSharedSkills(UDataTable* SkillsDataTable);
+
 	// --------------------------------------
 	//	Campaign
 	// --------------------------------------
@@ -110,6 +133,10 @@ private:
 	UPROPERTY(Transient)
 	UPlayerSaveGame* CurrentProfileSaveGame;
 
+	/** Skills shared between characters, mapped by the skills data table they were created from */
+	UPROPERTY(Transient)
+	TMap<UDataTable*, FSharedSkillSet> SharedSkills;
+
 protected:
 
 	// --------------------------------------
@@ -8,6 +8,7 @@
 
 class AEODCharacterBase;
 class AStatusEffectsManager;
+class ARegenerationManager;
 
 /**
  * 
@@ -40,11 +41,23 @@ public:
 	//	Manager Classes
 	// --------------------------------------
 
+	FORCEINLINE ARegenerationManager* GetRegenerationManager() const;
+
+	UFUNCTION(BlueprintPure, Category = Managers, meta = (DisplayName = "Get Regeneration Manager"))
+	ARegenerationManager* BP_GetRegenerationManager() const;
+
 	// FORCEINLINE AStatusEffectsManager* GetStatusEffectsManager() const;
 
 	// UFUNCTION(BlueprintPure, Category = Managers, meta = (DisplayName = "Get Status Effects Manager"))
 	// AStatusEffectsManager* BP_GetStatusEffectsManager() const;
 
+	// --------------------------------------
+	//	Combat
+	// --------------------------------------
+
+	/** Returns the seed of all combat random numbers in this game. Only valid after InitGame */
+	FORCEINLINE int32 GetCombatRandomSeed() const { return CombatRandomSeed; }
+
 protected:
 
 	/** Blueprint class used for spawning female characters */
@@ -55,6 +68,20 @@ protected:
 	UPROPERTY(EditAnywhere, NoClear, BlueprintReadOnly, Category = Classes)
 	TSubclassOf<AEODCharacterBase> MalePawnClass;
 
+	/** Blueprint class used for spawning regeneration manager */
+	UPROPERTY(EditAnywhere, NoClear, BlueprintReadOnly, Category = Classes)
+	TSubclassOf<ARegenerationManager> RegenerationManagerClass;
+
+	UPROPERTY(Transient)
+	ARegenerationManager* RegenerationManager;
+
+	/**
+	 * Seed of combat random numbers, e.g. crit rolls and AI skill selection. A random seed is picked if this is 0.
+	 * Can be overridden with the CombatSeed URL option to reproduce a logged encounter.
+	 */
+	UPROPERTY(Config, EditDefaultsOnly, BlueprintReadOnly, Category = Combat)
+	int32 CombatRandomSeed;
+
 	/** Blueprint class used for spawning status effect manager */
 	// UPROPERTY(EditAnywhere, NoClear, BlueprintReadOnly, Category = Classes)
 	// TSubclassOf<AStatusEffectsManager> StatusEffectsManagerClass;
@@ -64,6 +91,11 @@ protected:
 
 };
 
+FORCEINLINE ARegenerationManager* AEODGameModeBase::GetRegenerationManager() const
+{
+	return RegenerationManager;
+}
+
 /*
 FORCEINLINE AStatusEffectsManager* AEODGameModeBase::GetStatusEffectsManager() const
 {
@@ -0,0 +1,122 @@
+// Copyright 2018 Moikkai Games. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "GameFramework/Info.h"
+#include "RegenerationManager.generated.h"
+
+class UStatsComponentBase;
+
+/** Primary stats that can regenerate */
+enum class ERegeneratingStat : uint8
+{
+	Health,
+	Mana,
+	Stamina
+};
+
+/** A single stat of a stats component that is currently regenerating */
+struct FRegenerationEntry
+{
+	/** Stats component that owns the regenerating stat */
+	TWeakObjectPtr<UStatsComponentBase> StatsComp;
+
+	ERegeneratingStat Stat;
+
+	/** Delay between regeneration updates of this stat */
+	float TickInterval;
+
+	/** Time elapsed since this stat last regenerated */
+	float TimeSinceLastTick;
+
+	/** Number of regeneration updates that are due during the current regeneration pass */
+	int32 PendingTicks;
+
+	/** True if the regeneration has been stopped and the entry is waiting to be removed */
+	bool bStopped;
+};
+
+/** Identifies the entry of a regenerating stat. Weak pointers hash by object index, so keys stay valid after the component is destroyed */
+typedef TPair<TWeakObjectPtr<const UStatsComponentBase>, uint8> FRegenerationKey;
+
+/**
+ * Regenerates the primary stats of all characters in the world.
+ * Regenerating stats are stored in a single contiguous array that is updated in one batched pass at a fixed interval,
+ * instead of each character running a timer for each of its regenerating stats.
+ */
+UCLASS(BlueprintType, Blueprintable, Config = Game)
+class EOD_API ARegenerationManager : public AInfo
+{
+	GENERATED_BODY()
+
+public:
+
+	// --------------------------------------
+	//  UE4 Method Overrides
+	// --------------------------------------
+
+	ARegenerationManager(const FObjectInitializer& ObjectInitializer);
+
+	virtual void BeginPlay() override;
+
+	virtual void Tick(float DeltaTime) override;
+
+	// --------------------------------------
+	//  Regeneration
+	// --------------------------------------
+
+	/** Starts regenerating Stat of StatsComp every TickInterval seconds. Only updates the interval if the stat is already regenerating */
+	void StartRegeneration(UStatsComponentBase* StatsComp, ERegeneratingStat Stat, float TickInterval);
+
+	/** Stops regenerating Stat of StatsComp. Safe to call during a regeneration pass, the entry is removed at the end of the pass */
+	void StopRegeneration(UStatsComponentBase* StatsComp, ERegeneratingStat Stat);
+
+	FORCEINLINE int32 GetNumRegeneratingStats() const { return NumActiveEntries; }
+
+	/** Interval in seconds between regeneration passes. Stats with a shorter tick interval than this catch up on the next pass */
+	UPROPERTY(Config, EditDefaultsOnly, Category = Regeneration)
+	float RegenerationPassInterval;
+
+	/** If true, due regeneration updates are counted on worker threads when there are at least MinEntriesForParallelPass regenerating stats */
+	UPROPERTY(Config, EditDefaultsOnly, Category = Regeneration)
+	bool bUseParallelPass;
+
+	UPROPERTY(Config, EditDefaultsOnly, Category = Regeneration)
+	int32 MinEntriesForParallelPass;
+
+private:
+
+	/** Returns the index of the entry of Stat of StatsComp, or INDEX_NONE if the stat isn't regenerating */
+	int32 FindEntry(const UStatsComponentBase* StatsComp, ERegeneratingStat Stat) const;
+
+	static FORCEINLINE FRegenerationKey MakeKey(const TWeakObjectPtr<const UStatsComponentBase>& StatsComp, ERegeneratingStat Stat)
+	{
+		return FRegenerationKey(StatsComp, (uint8)Stat);
+	}
+
+	/** Marks the entry at Index as stopped and removes it from EntryIndices */
+	void StopEntry(int32 Index);
+
+	/** Advances the time of all entries by DeltaTime and counts the regeneration updates that are due */
+	void CountPendingTicks(float DeltaTime);
+
+	/** Applies the due regeneration updates to the stats */
+	void ApplyPendingTicks();
+
+	/** Removes the entries that were stopped */
+	void RemoveStoppedEntries();
+
+	/** All regenerating stats, including stopped entries until the end of the current pass */
+	TArray<FRegenerationEntry> Entries;
+
+	/** Maps the key of every entry that hasn't been stopped to its index in Entries */
+	TMap<FRegenerationKey, int32> EntryIndices;
+
+	int32 NumActiveEntries;
+
+	/** True if any entry has been stopped since stopped entries were last removed */
+	bool bHasStoppedEntries;
+
+};
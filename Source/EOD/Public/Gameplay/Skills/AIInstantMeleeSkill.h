@@ -18,12 +18,7 @@ public:
 
 	UAIInstantMeleeSkill(const FObjectInitializer& ObjectInitializer);
 
-	/** Trigger this skill, i.e., either instantly activate this skill or start charging this skill. */
-	virtual void TriggerSkill() override;
-
-protected:
-
-	FTimerHandle SkillTimerHandle;
-
+	/** Trigger this skill for the owner of SkillsComp */
+	virtual void TriggerSkillFor(UAISkillsComponent* SkillsComp) override;
 
 };
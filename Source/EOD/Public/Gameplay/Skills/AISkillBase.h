@@ -9,6 +9,7 @@
 
 class UCameraShake;
 class UGameplayEffectBase;
+class UAISkillsComponent;
 
 USTRUCT(BlueprintType, DisplayName = "AI Skill Info")
 struct EOD_API FAISkillInfo
@@ -59,7 +60,10 @@ struct EOD_API FAISkillInfo
 };
 
 /**
- * 
+ * The base class for all skills used by AI characters.
+ * A single object of each AI skill is shared by every AI character that uses the same skills data table (see UEODGameInstance::GetSharedSkills),
+ * so AI skills never cache an instigator. Instead, the skills component of the character using the skill is passed to every call
+ * and holds all of the per character state (active skills, cooldowns, skill timer).
  */
 UCLASS()
 class EOD_API UAISkillBase : public UGameplaySkillBase
@@ -71,19 +75,33 @@ public:
 	UAISkillBase(const FObjectInitializer& ObjectInitializer);
 
 	// --------------------------------------
-	//	Gameplay Skill Interface
+	//	AI Skill Interface
 	// --------------------------------------
 
-	virtual bool CanTriggerSkill() const override;
+	virtual bool CanReleaseSkill() const override;
 
-	/** Trigger this skill, i.e., either instantly activate this skill or start charging this skill. */
+	//~ AI skills are shared and have no instigator. The instigator based interface below is not supported,
+	//~ use the *For versions that take the skills component of the character using the skill instead.
+	virtual bool CanTriggerSkill() const override;
 	virtual void TriggerSkill() override;
+	virtual void CancelSkill() override;
+	virtual void FinishSkill() override;
+	virtual bool GetAttackInfo(int32 CollisionIndex, FAttackInfo& OutAttackInfo) override;
 
-	virtual bool CanReleaseSkill() const override;
+	/** Returns true if the owner of SkillsComp can trigger this skill */
+	virtual bool CanTriggerSkillFor(UAISkillsComponent* SkillsComp) const;
 
-	virtual void FinishSkill() override;
+	/** Trigger this skill for the owner of SkillsComp */
+	virtual void TriggerSkillFor(UAISkillsComponent* SkillsComp);
+
+	/** Cancel this skill for the owner of SkillsComp */
+	virtual void CancelSkillFor(UAISkillsComponent* SkillsComp);
 
-	virtual TSharedPtr<FAttackInfo> GetAttackInfoPtr(int32 CollisionIndex = 1) override;
+	/** Finish this skill for the owner of SkillsComp */
+	virtual void FinishSkillFor(UAISkillsComponent* SkillsComp);
+
+	/** Fills OutAttackInfo with the attack info of this skill used by the owner of SkillsComp */
+	virtual bool GetAttackInfoFor(UAISkillsComponent* SkillsComp, int32 CollisionIndex, FAttackInfo& OutAttackInfo) const;
 
 	// --------------------------------------
 	//  Pseudo Constants
@@ -105,6 +123,4 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Skill Info")
 	FAISkillInfo SkillInfo;
 
-	float SkillDuration;
-
 };
@@ -129,7 +129,7 @@ public:
 
 	virtual void LoseCCImmunities();
 
-	virtual TSharedPtr<FAttackInfo> GetAttackInfoPtr(int32 CollisionIndex = 1) override;
+	virtual bool GetAttackInfo(int32 CollisionIndex, FAttackInfo& OutAttackInfo) override;
 
 	inline FActiveSkillLevelUpInfo GetCurrentSkillLevelupInfo() const;
 
@@ -137,12 +137,8 @@ protected:
 
 	virtual void StartCooldown() override;
 
-	virtual void FinishCooldown() override;
-
 	virtual void CancelCooldown() override;
 
-	virtual void UpdateCooldown() override;
-
 	// --------------------------------------
 	//  Pseudo Constants : Default values that are not supposed to be modified
 	// --------------------------------------
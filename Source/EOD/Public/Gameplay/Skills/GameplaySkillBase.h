@@ -55,7 +55,8 @@ public:
 
 	virtual void DisableGameplayEffectEvents() { ; }
 
-	virtual TSharedPtr<FAttackInfo> GetAttackInfoPtr(int32 CollisionIndex = 1);
+	/** Fills OutAttackInfo with the attack info for the given collision index. Returns false if this skill has no attack info */
+	virtual bool GetAttackInfo(int32 CollisionIndex, FAttackInfo& OutAttackInfo);
 
 	/** Returns true if this skill is valid, i.e, skill belongs to a valid skill group */
 	FORCEINLINE bool IsValid() const { return SkillGroup != NAME_None && SkillIndex != 0; }
@@ -168,7 +169,7 @@ protected:
 
 	/** 
 	 * This is used to identify skill during replication. SkillIndex(uint8) is cheaper to replicate than SkillID(FName)
-	 * This will be set by the gameplay skill component when an object of this class is created.
+	 * This will be set when an object of this class is created from a row of a skills data table.
 	 */
 	UPROPERTY(Transient)
 	uint8 SkillIndex;
@@ -76,9 +76,10 @@ public:
 	inline bool IsUnlocked() const { return CurrentUpgrade > 0; }
 
 	/** Returns true if this skill is currently in cooldown */
-	inline bool IsSkillInCooldown() const { return CooldownRemaining > 0.f; }
+	bool IsSkillInCooldown() const;
 
-	inline float GetRemainingCooldown() const { return CooldownRemaining; }
+	/** Returns the cooldown time remaining in seconds, read from the cooldowns of the instigator's skill component */
+	float GetRemainingCooldown() const;
 
 	FORCEINLINE int32 GetCurrentUpgrade() const { return CurrentUpgrade; }
 
@@ -88,23 +89,12 @@ protected:
 
 	int32 CurrentUpgrade;
 
-	UPROPERTY()
-	FTimerHandle CooldownTimerHandle;
-
-	float CooldownRemaining;
-
 	UFUNCTION()
 	virtual void StartCooldown();
 
-	UFUNCTION()
-	virtual void FinishCooldown();
-
 	UFUNCTION()
 	virtual void CancelCooldown();
 
-	UFUNCTION()
-	virtual void UpdateCooldown();
-
 	// --------------------------------------
 	//  Utility
 	// --------------------------------------
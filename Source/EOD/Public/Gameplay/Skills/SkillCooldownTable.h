@@ -0,0 +1,58 @@
+// Copyright 2018 Moikkai Games. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Cooldowns of the skills of a single skills component, stored as the world time at which the cooldown of each skill index ends.
+ * Pending cooldowns are also kept in a min heap ordered by end time, so the owner only ever has to wait on the next cooldown to expire.
+ */
+class EOD_API FSkillCooldownTable
+{
+public:
+
+	/** Puts the skill at SkillIndex in cooldown until EndTime. Restarting a cooldown replaces its end time */
+	void StartCooldown(uint8 SkillIndex, float EndTime);
+
+	/** Ends the cooldown of the skill at SkillIndex without it expiring. Returns false if the skill was not in cooldown */
+	bool CancelCooldown(uint8 SkillIndex);
+
+	FORCEINLINE float GetRemainingTime(uint8 SkillIndex, float CurrentTime) const
+	{
+		return EndTimes.IsValidIndex(SkillIndex) ? FMath::Max(EndTimes[SkillIndex] - CurrentTime, 0.f) : 0.f;
+	}
+
+	FORCEINLINE bool IsInCooldown(uint8 SkillIndex, float CurrentTime) const { return GetRemainingTime(SkillIndex, CurrentTime) > 0.f; }
+
+	/** Outs the end time of the cooldown that expires next. Returns false if no skill is in cooldown */
+	bool GetNextEndTime(float& OutEndTime);
+
+	/** Removes a cooldown that has ended by CurrentTime and outs its skill index. Returns false if no cooldown has ended */
+	bool PopExpiredCooldown(float CurrentTime, uint8& OutSkillIndex);
+
+	void Reset();
+
+private:
+
+	struct FCooldownEntry
+	{
+		float EndTime;
+
+		uint8 SkillIndex;
+	};
+
+	struct FCooldownEntryPredicate
+	{
+		FORCEINLINE bool operator()(const FCooldownEntry& A, const FCooldownEntry& B) const { return A.EndTime < B.EndTime; }
+	};
+
+	/** Discards heap entries of cooldowns that have been cancelled or restarted since they were pushed */
+	void DiscardStaleEntries();
+
+	/** End time of the cooldown of every skill index. 0 if the skill is not in cooldown */
+	TArray<float> EndTimes;
+
+	TArray<FCooldownEntry> CooldownHeap;
+
+};
@@ -0,0 +1,95 @@
+// Copyright 2018 Moikkai Games. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CombatLibrary.h"
+#include "Animation/AnimNotifies/AnimNotifyState.h"
+#include "AnimNotifyState_SweptCollision.generated.h"
+
+class AActor;
+class USkeletalMeshComponent;
+
+/** Runtime state of a single swing, i.e, a single mesh component playing this notify state */
+struct FSweptCollisionSwing
+{
+	/** Socket transform of the blade at the end of the last processed frame */
+	FTransform LastSocketTransform;
+
+	/** Actors that have already been hit during this swing */
+	TArray<TWeakObjectPtr<AActor>> HitActors;
+
+	/** Swing id that every hit request of this swing is queued with */
+	uint32 SwingId;
+};
+
+/**
+ * An anim notify state that sweeps a weapon blade capsule along the path of a socket, frame to frame, for as long as the notify state is active.
+ * Unlike the instant collision notifies this does not miss targets that the weapon passes through between two frames.
+ */
+UCLASS()
+class EOD_API UAnimNotifyState_SweptCollision : public UAnimNotifyState
+{
+	GENERATED_BODY()
+
+public:
+
+	UAnimNotifyState_SweptCollision(const FObjectInitializer& ObjectInitializer);
+
+	virtual void NotifyBegin(USkeletalMeshComponent* MeshComp, UAnimSequenceBase* Animation, float TotalDuration) override;
+
+	virtual void NotifyTick(USkeletalMeshComponent* MeshComp, UAnimSequenceBase* Animation, float FrameDeltaTime) override;
+
+	virtual void NotifyEnd(USkeletalMeshComponent* MeshComp, UAnimSequenceBase* Animation) override;
+
+	/** Socket that the weapon blade is attached to */
+	UPROPERTY(EditAnywhere, Category = BladeInfo)
+	FName SocketName;
+
+	/** Start of the blade in socket space */
+	UPROPERTY(EditAnywhere, Category = BladeInfo)
+	FVector BladeStart;
+
+	/** End (tip) of the blade in socket space */
+	UPROPERTY(EditAnywhere, Category = BladeInfo)
+	FVector BladeEnd;
+
+	/** Radius of the blade capsule */
+	UPROPERTY(EditAnywhere, Category = BladeInfo)
+	float BladeRadius;
+
+	/**
+	 * The maximum distance the blade tip may travel in a single sweep.
+	 * Frame movement larger than this (e.g. due to a low tick rate) is split into multiple sub-steps.
+	 */
+	UPROPERTY(EditAnywhere, Category = Sweep, meta = (ClampMin = "1.0"))
+	float MaxSubStepDistance;
+
+	/** The maximum number of sweeps a single swing can do in a frame */
+	UPROPERTY(EditAnywhere, Category = Sweep, meta = (ClampMin = "1"))
+	int32 MaxSweepsPerFrame;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = SkillInfo)
+	FCollisionSkillInfo SkillInfo;
+
+private:
+
+	/** Returns the world transform of the blade socket */
+	FTransform GetSocketTransform(USkeletalMeshComponent* MeshComp) const;
+
+	/** Sweeps the blade from the last processed socket transform to the current one */
+	void SweepBlade(USkeletalMeshComponent* MeshComp, FSweptCollisionSwing& Swing, const FTransform& CurrentSocketTransform);
+
+	/**
+	 * Swings that are in progress, keyed by the mesh component playing them.
+	 * Notify states are shared by every mesh playing the animation, so per swing state can't live in member variables.
+	 */
+	TMap<TWeakObjectPtr<USkeletalMeshComponent>, FSweptCollisionSwing> ActiveSwings;
+
+	/** Scratch buffer for sweep results */
+	TArray<FHitResult> ScratchHitResults;
+
+	/** Scratch buffer for the results of a single sub-step sweep */
+	TArray<FHitResult> SubStepHitResults;
+
+};
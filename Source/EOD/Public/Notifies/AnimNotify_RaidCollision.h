@@ -34,6 +34,38 @@ public:
 
 };
 
+/** Local (mesh) space shape of a FRaidCapsule, baked so that runtime only has to transform it to world space */
+USTRUCT()
+struct FBakedRaidCapsule
+{
+	GENERATED_USTRUCT_BODY()
+
+public:
+
+	UPROPERTY(VisibleAnywhere, Category = ShapeInfo)
+	FVector Center;
+
+	UPROPERTY(VisibleAnywhere, Category = ShapeInfo)
+	FQuat Rotation;
+
+	UPROPERTY(VisibleAnywhere, Category = ShapeInfo)
+	float Radius;
+
+	UPROPERTY(VisibleAnywhere, Category = ShapeInfo)
+	float HalfHeight;
+
+	FBakedRaidCapsule() :
+		Center(FVector::ZeroVector),
+		Rotation(FQuat::Identity),
+		Radius(0.f),
+		HalfHeight(0.f)
+	{
+	}
+
+	explicit FBakedRaidCapsule(const FRaidCapsule& Capsule);
+
+};
+
 /**
  * An anim notify class to handle collisions of RaiderZ format
  */
@@ -46,11 +78,26 @@ public:
 
 	virtual void Notify(USkeletalMeshComponent* MeshComp, UAnimSequenceBase* Animation) override;
 
+	virtual void PostLoad() override;
+
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
 	/** Capsules that will be used for doing collision tests */
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = CollisionInfo)
 	TArray<FRaidCapsule> CollisionCapsules;	
+
+	/** Rebuilds BakedCapsules from CollisionCapsules. Must be called whenever CollisionCapsules is modified */
+	void BakeCollisionCapsules();
 	
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = SkillInfo)
 	FCollisionSkillInfo SkillInfo;
 
+private:
+
+	/** Local space shapes of CollisionCapsules */
+	UPROPERTY(VisibleAnywhere, Category = CollisionInfo)
+	TArray<FBakedRaidCapsule> BakedCapsules;
+
 };
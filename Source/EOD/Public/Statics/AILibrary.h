@@ -3,9 +3,106 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Engine/DataTable.h"
 #include "UObject/NoExportTypes.h"
 #include "AILibrary.generated.h"
 
+class AEODCharacterBase;
+
+/** The state of a character that AI characters select their skills against. Captured at most once per frame for every targeted character */
+struct EOD_API FAITargetSnapshot
+{
+	FVector Location;
+
+	FVector ForwardVector;
+
+	/** Current health of the character relative to its maximum health */
+	float HealthRatio;
+
+	/** Mask of crowd control effects the character is immune to */
+	uint8 CCImmunities;
+
+	uint8 bBlocking : 1;
+
+	uint8 bDodging : 1;
+
+	uint8 bUsingSkill : 1;
+
+	/** True if the character is reacting to a hit, i.e., it's under a crowd control effect */
+	uint8 bHasBeenHit : 1;
+
+	FAITargetSnapshot();
+
+	/** Captures the current state of Character */
+	void Capture(const AEODCharacterBase* Character);
+};
+
+/** Weights that an AI character scores the utility of its attack skills with against the state of its target */
+USTRUCT(BlueprintType)
+struct EOD_API FAISkillUtilityTableRow : public FTableRowBase
+{
+	GENERATED_USTRUCT_BODY()
+
+	/** Added to unblockable skills if the target is blocking while facing the AI character */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Skill Utility")
+	float UnblockableVsBlocking;
+
+	/** Subtracted from blockable skills if the target is blocking while facing the AI character */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Skill Utility")
+	float BlockablePenalty;
+
+	/** Added to undodgable skills if the target is dodging */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Skill Utility")
+	float UndodgableVsDodging;
+
+	/** Added to interrupt skills if the target is using a skill */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Skill Utility")
+	float InterruptVsUsingSkill;
+
+	/** Added to skills that only make the target flinch if the target is already under a crowd control effect */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Skill Utility")
+	float NormalVsHit;
+
+	/** Added to crowd control skills if the target is free to act */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Skill Utility")
+	float CCEVsIdle;
+
+	/** Subtracted from crowd control skills if the target is immune to their crowd control effect */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Skill Utility")
+	float CCEImmunePenalty;
+
+	/** Multiplied with the damage percent of a skill and the missing health ratio of the target, so stronger skills are preferred against weakened targets */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Skill Utility")
+	float DamageVsLowHealth;
+
+	/** Subtracted from melee skills if the target is out of melee range, and from ranged skills if the target is within melee range */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Skill Utility")
+	float OutOfRangePenalty;
+
+	/** Subtracted from the skill that was used last */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Skill Utility")
+	float LastUsedPenalty;
+
+	/** Upper limit of a random utility added to every skill, so equally useful skills are picked at random */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Skill Utility")
+	float Randomness;
+
+	FAISkillUtilityTableRow() :
+		UnblockableVsBlocking(4.f),
+		BlockablePenalty(2.f),
+		UndodgableVsDodging(3.f),
+		InterruptVsUsingSkill(3.f),
+		NormalVsHit(2.f),
+		CCEVsIdle(2.f),
+		CCEImmunePenalty(3.f),
+		DamageVsLowHealth(1.f),
+		OutOfRangePenalty(5.f),
+		LastUsedPenalty(5.f),
+		Randomness(1.f)
+	{
+	}
+};
+
 /**
  * 
  */
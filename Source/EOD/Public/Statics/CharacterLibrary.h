@@ -1009,6 +1009,13 @@ public:
 
 	static bool AreEnemies(AEODCharacterBase* CharacterOne, AEODCharacterBase* CharacterTwo);
 
+	/**
+	 * Returns the collision mask filter bit of a faction. Character bodies are tagged with their faction's bit,
+	 * so that combat queries can skip friendly characters using FCollisionQueryParams::IgnoreMask.
+	 * @note The physics mask filter only has 6 bits, which limits EFaction to 6 entries.
+	 */
+	static FMaskFilter GetFactionMaskFilter(EFaction Faction);
+
 	//~ Begin anim montage section names
 	static const FName SectionName_ForwardFlinch;
 	
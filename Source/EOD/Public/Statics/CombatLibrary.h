@@ -166,6 +166,11 @@ struct EOD_API FCollisionSkillInfo
 		CollisionIndex(1)
 	{
 	}
+
+	FORCEINLINE bool operator == (const FCollisionSkillInfo& Other) const
+	{
+		return (this->SkillGroup == Other.SkillGroup && this->CollisionIndex == Other.CollisionIndex);
+	}
 };
 
 
@@ -327,8 +332,11 @@ public:
 
 	static FCollisionQueryParams GenerateCombatCollisionQueryParams(const AActor* ActorToIgnore, EQueryMobilityType MobilityType = EQueryMobilityType::Dynamic, bool bReturnPhysicalMaterial = true, FName TraceTag = FName("CollisionQueryForCombat"));
 
+	/** Returns Attack reduced by Defense. Defense equal to DamageResistanceScale halves the damage */
 	static float CalculateDamage(float Attack, float Defense);
 
+	static const float DamageResistanceScale;
+
 	static const float PhysicalCritMultiplier;
 	static const float MagickalCritMultiplier;
 
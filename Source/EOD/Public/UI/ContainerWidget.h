@@ -249,12 +249,17 @@ protected:
 	UPROPERTY(Transient)
 	bool bIsInCooldown;
 
-	float CooldownRemaining;
+	/** World time at which the cooldown displayed by this container ends */
+	float CooldownEndTime;
 
 	void EnableCooldownText();
 
 	void DisableCooldownText();
 
+	/** Bound to CooldownText, so the remaining cooldown is only computed when the text is painted */
+	UFUNCTION()
+	FText GetCooldownText() const;
+
 public:
 
 	// --------------------------------------
@@ -137,7 +137,7 @@ public:
 
 	void SetSkillOwnerComponent(UPlayerSkillsComponent* SkillsComponent);
 
-	void InitializeSkillBarLayout(const TMap<uint8, uint8>& SkillBarMap, const TMap<uint8, UGameplaySkillBase*>& SkillsMap);
+	void InitializeSkillBarLayout(const TMap<uint8, uint8>& SkillBarMap, const TArray<UGameplaySkillBase*>& Skills);
 
 protected:
 
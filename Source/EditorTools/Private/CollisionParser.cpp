@@ -218,6 +218,7 @@ void UCollisionParser::ImportAndApplyCollisionInfo()
 						if (RaidCollisionNotify)
 						{
 							RaidCollisionNotify->CollisionCapsules = CollisionInfo.Capsules;
+							RaidCollisionNotify->BakeCollisionCapsules();
 						}
 
 						NewEvent.NotifyName = FName(*NewEvent.Notify->GetNotifyName());